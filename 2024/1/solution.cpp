@@ -5,6 +5,8 @@
 #include <vector>
 #include <unordered_map>
 
+#include "../common/instrument.hpp"
+
 struct parse_result_type;
 
 parse_result_type parse_from_file(std::fstream&&);
@@ -24,6 +26,8 @@ struct parse_result_type {
 };
 
 parse_result_type parse_from_file(std::fstream&& file) {
+    INSTRUMENT_PHASE("parse_from_file");
+
     parse_result_type res;
     int               a, b;
 
@@ -42,6 +46,8 @@ void calculate(parse_result_type&& data) {
 }
 
 void solve_q1(parse_result_type& data) {
+    INSTRUMENT_PHASE("solve_q1");
+
     using std::begin;
     using std::end;
     using std::size;
@@ -58,6 +64,8 @@ void solve_q1(parse_result_type& data) {
 }
 
 void solve_q2(parse_result_type& data) {
+    INSTRUMENT_PHASE("solve_q2");
+
     std::unordered_map<int, int> counter;
     int                          ans = 0;
 
@@ -70,4 +78,6 @@ void solve_q2(parse_result_type& data) {
     std::cout << ans << std::endl;
 }
 
-int main() { calculate(parse_from_file(std::fstream("data.txt"))); }
+int main(int argc, char* argv[]) {
+    calculate(parse_from_file(std::fstream(argc > 1 ? argv[1] : "data.txt")));
+}
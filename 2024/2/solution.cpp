@@ -1,34 +1,56 @@
 #include <algorithm>
+#include <array>
+#include <cstddef>
 #include <fstream>
 #include <iostream>
 #include <iterator>
+#include <memory>
+#include <memory_resource>
 #include <numeric>
+#include <utility>
 #include <valarray>
 #include <vector>
 
+#include "../common/arena.hpp"
+#include "../common/instrument.hpp"
+
 struct Data;
 
+using Report = std::pmr::vector<int>;
+
 Data parse_from(std::fstream&&);
 void solve(Data&&);
 void solve_q1(Data&);
 void solve_q2(Data&);
-bool is_safe(const std::vector<int>&);
-bool is_safe_2(const std::vector<int>&);
+bool is_safe(const Report&);
+bool is_safe_2(const Report&);
 
+// Arena bytes per input byte: each report of a handful of two-digit levels becomes a vector of
+// ints that is grown by doubling, so earlier buffers stay in the arena.
+constexpr std::size_t ARENA_BYTES_PER_INPUT_BYTE = 8;
+
+// The reports live in `arena`.
 struct Data {
-    std::vector<std::vector<int>> data;
+    std::unique_ptr<Arena>   arena;
+    std::pmr::vector<Report> data;
+
+    Data() = default;
+    explicit Data(std::unique_ptr<Arena> resource) :
+        arena(std::move(resource)),
+        data(arena.get()) {}
 
-    Data()                       = default;
     Data(const Data&)            = delete;
     Data& operator=(const Data&) = delete;
     Data(Data&&)                 = default;
-    Data& operator=(Data&&)      = default;
+    Data& operator=(Data&&)      = delete;
 };
 
 Data parse_from(std::fstream&& file) {
-    std::vector<int> line;
-    Data             result;
-    int              num;
+    INSTRUMENT_PHASE("parse_from");
+
+    Data   result{make_arena(file, ARENA_BYTES_PER_INPUT_BYTE)};
+    Report line{result.arena.get()};
+    int    num;
 
     while (file >> num)
     {
@@ -50,29 +72,34 @@ void solve(Data&& data) {
 }
 
 void solve_q1(Data& data) {
+    INSTRUMENT_PHASE("solve_q1");
+
     using std::cbegin;
     using std::cend;
 
     int ans = 0;
 
-    std::cout << std::reduce(cbegin(data.data), cend(data.data), 0,
-                             [](int acc, const std::vector<int> row) { return acc + is_safe(row); })
+    std::cout << std::accumulate(
+      cbegin(data.data), cend(data.data), 0,
+      [](int acc, const Report& row) { return acc + is_safe(row); })
               << std::endl;
 }
 
 void solve_q2(Data& data) {
+    INSTRUMENT_PHASE("solve_q2");
+
     using std::cbegin;
     using std::cend;
 
     int ans = 0;
 
-    std::cout << std::reduce(
-      cbegin(data.data), cend(data.data), 0, [](int acc, const std::vector<int> row) {
+    std::cout << std::accumulate(
+      cbegin(data.data), cend(data.data), 0, [](int acc, const Report& row) {
           return acc + is_safe_2(row);
       }) << std::endl;
 }
 
-bool is_safe(const std::vector<int>& row) {
+bool is_safe(const Report& row) {
     using std::size;
 
     int prev_diff = row.at(1) - row.at(0);
@@ -92,13 +119,16 @@ bool is_safe(const std::vector<int>& row) {
     return true;
 }
 
-bool is_safe_2(const std::vector<int>& row) {
+bool is_safe_2(const Report& row) {
     using std::size;
 
     if (is_safe(row))
         return true;
 
-    std::vector<int> new_row;
+    // Reports are short, so the candidate rows normally fit in a buffer on the stack.
+    std::array<std::byte, 256>          buffer;
+    std::pmr::monotonic_buffer_resource scratch{buffer.data(), size(buffer)};
+    Report                              new_row{&scratch};
 
     new_row.reserve(size(row) - 1);
 
@@ -121,4 +151,6 @@ bool is_safe_2(const std::vector<int>& row) {
     return false;
 }
 
-int main() { solve(parse_from(std::fstream("data.txt"))); }
+int main(int argc, char* argv[]) {
+    solve(parse_from(std::fstream(argc > 1 ? argv[1] : "data.txt")));
+}
@@ -6,6 +6,8 @@
 #include <string>
 #include <utility>
 
+#include "../common/instrument.hpp"
+
 struct Data;
 
 Data parse_from(std::fstream&&);
@@ -26,6 +28,8 @@ struct Data {
 };
 
 Data parse_from(std::fstream&& file) {
+    INSTRUMENT_PHASE("parse_from");
+
     Data               result;
     std::ostringstream read_stream;
     std::string        line;
@@ -44,9 +48,15 @@ void solve(Data&& data) {
     solve_q2(data);
 }
 
-void solve_q1(const Data& data) { std::cout << evaluate_string(data.data) << std::endl; }
+void solve_q1(const Data& data) {
+    INSTRUMENT_PHASE("solve_q1");
+
+    std::cout << evaluate_string(data.data) << std::endl;
+}
 
 void solve_q2(const Data& data) {
+    INSTRUMENT_PHASE("solve_q2");
+
     using std::cbegin;
     using std::cend;
 
@@ -84,4 +94,6 @@ int evaluate_instruction(const std::smatch& instruction) {
     return std::stoi(instruction[1]) * std::stoi(instruction[2]);
 }
 
-int main() { solve(parse_from(std::fstream{"data.txt"})); }
+int main(int argc, char* argv[]) {
+    solve(parse_from(std::fstream{argc > 1 ? argv[1] : "data.txt"}));
+}
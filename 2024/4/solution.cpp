@@ -1,70 +1,34 @@
-#include <array>
 #include <fstream>
 #include <iostream>
 #include <iterator>
+#include <memory_resource>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "../common/arena.hpp"
+#include "../common/grid.hpp"
+#include "../common/instrument.hpp"
+
 struct Data;
-struct Direction;
-struct Position;
 
 Data parse_from(std::fstream&&);
 void solve(Data&&);
 void solve_q1(const Data&);
 void solve_q2(const Data&);
-int  search_all_matches(const std::vector<std::string>&, const std::string&, const Position);
-bool cross_xmas_match(const std::vector<std::string>&, const Position);
-bool match_success(const std::vector<std::string>&, const std::string&, Position, const Direction);
-
-constexpr Position  operator+(const Position, const Direction) noexcept;
-constexpr Position& operator+=(Position&, const Direction) noexcept;
-
-constexpr Direction operator+(const Direction, const Direction) noexcept;
-
-struct Direction {
-    const int x;
-    const int y;
-
-    constexpr Direction(const int a, const int b) :
-        x(a),
-        y(b) {}
-};
-
-constexpr Direction operator+(const Direction first, const Direction second) noexcept {
-    return Direction(first.x + second.x, first.y + second.y);
-}
+int  search_all_matches(const Grid<char>&, const std::string&, const Position);
+bool cross_xmas_match(const Grid<char>&, const Position);
+bool match_success(const Grid<char>&, const std::string&, Position, const Direction);
 
-constexpr Direction N{1, 0};
-constexpr Direction S{-1, 0};
-constexpr Direction E{0, 1};
-constexpr Direction W{0, -1};
+// Words are at most this long, so a match attempt starting inside the grid steps at most this
+// many cells into the padding and never needs a bounds check.
+constexpr int MAX_WORD_LENGTH = 4;
 
-constexpr Direction NE = N + E;
-constexpr Direction NW = N + W;
-constexpr Direction SE = S + E;
-constexpr Direction SW = S + W;
-
-constexpr std::array<Direction, 8> ALL_DIRECTIONS{N, S, E, W, NE, NW, SE, SW};
-
-struct Position {
-    int x;
-    int y;
-};
-
-constexpr Position operator+(const Position pos, const Direction direction) noexcept {
-    return Position{pos.x + direction.x, pos.y + direction.y};
-}
-
-constexpr Position& operator+=(Position& pos, const Direction direction) noexcept {
-    pos.x += direction.x;
-    pos.y += direction.y;
-    return pos;
-}
+// Arena bytes per input byte: the lines are copied once before being laid out in the grid.
+constexpr std::size_t ARENA_BYTES_PER_INPUT_BYTE = 2;
 
 struct Data {
-    std::vector<std::string> data;
+    Grid<char> grid;
 
     Data()                       = default;
     Data(const Data&)            = delete;
@@ -74,14 +38,30 @@ struct Data {
 };
 
 Data parse_from(std::fstream&& file) {
-    Data        result;
-    std::string line;
+    INSTRUMENT_PHASE("parse_from");
+
+    using std::size;
+
+    const auto arena = make_arena(file, ARENA_BYTES_PER_INPUT_BYTE);
+
+    Data                               result;
+    std::string                        line;
+    std::pmr::vector<std::pmr::string> lines{arena.get()};
 
     while (file >> line)
     {
-        result.data.push_back(std::move(line));
+        lines.emplace_back(line);
     }
 
+    if (lines.empty())
+        return result;
+
+    result.grid = Grid<char>{size(lines), size(lines[0]), MAX_WORD_LENGTH - 1, '.'};
+
+    for (int x = 0; x < size(lines); x++)
+        for (int y = 0; y < size(lines[x]); y++)
+            result.grid[Position{x, y}] = lines[x][y];
+
     return result;
 }
 
@@ -91,32 +71,36 @@ void solve(Data&& data) {
 }
 
 void solve_q1(const Data& data) {
+    INSTRUMENT_PHASE("solve_q1");
+
     using std::size;
 
     int ans = 0;
 
-    for (int x = 0; x < size(data.data); x++)
-        for (int y = 0; y < size(data.data[0]); y++)
-            ans += search_all_matches(data.data, "XMAS", Position{x, y});
+    for (int x = 0; x < data.grid.height(); x++)
+        for (int y = 0; y < data.grid.width(); y++)
+            ans += search_all_matches(data.grid, "XMAS", Position{x, y});
 
     std::cout << ans << std::endl;
 }
 
 void solve_q2(const Data& data) {
+    INSTRUMENT_PHASE("solve_q2");
+
     using std::size;
 
     int ans = 0;
 
-    for (int x = 1; x + 1 < size(data.data); x++)
-        for (int y = 1; y + 1 < size(data.data[0]); y++)
-            ans += cross_xmas_match(data.data, Position{x, y});
+    for (int x = 1; x + 1 < data.grid.height(); x++)
+        for (int y = 1; y + 1 < data.grid.width(); y++)
+            ans += cross_xmas_match(data.grid, Position{x, y});
 
     std::cout << ans << std::endl;
 }
 
-int search_all_matches(const std::vector<std::string>& map,
-                       const std::string&              to_search,
-                       const Position                  position) {
+int search_all_matches(const Grid<char>&  map,
+                       const std::string& to_search,
+                       const Position     position) {
     using std::size;
 
     int ans = 0;
@@ -127,31 +111,21 @@ int search_all_matches(const std::vector<std::string>& map,
     return ans;
 }
 
-bool cross_xmas_match(const std::vector<std::string>& map, const Position position) {
-    const auto [x, y] = position;
-
-    if (x < 1 || y < 1 || x + 1 >= size(map) || y + 1 >= size(map.at(0)))
-        return false;
-
-    return (match_success(map, "MAS", Position{x + 1, y + 1}, SW)
-            || match_success(map, "SAM", Position{x + 1, y + 1}, SW))
-        && (match_success(map, "MAS", Position{x - 1, y + 1}, NW)
-            || match_success(map, "SAM", Position{x - 1, y + 1}, NW));
+bool cross_xmas_match(const Grid<char>& map, const Position position) {
+    return (match_success(map, "MAS", position + NW, SE)
+            || match_success(map, "SAM", position + NW, SE))
+        && (match_success(map, "MAS", position + SW, NE)
+            || match_success(map, "SAM", position + SW, NE));
 }
 
-bool match_success(const std::vector<std::string>& map,
-                   const std::string&              to_search,
-                   Position                        position,
-                   const Direction                 direction) {
-    using std::size;
-
+// `to_search` must be at most `MAX_WORD_LENGTH` long; the padding stops runs off the edge.
+bool match_success(const Grid<char>&  map,
+                   const std::string& to_search,
+                   Position           position,
+                   const Direction    direction) {
     for (const char character : to_search)
     {
-        if (position.x < 0 || position.y < 0 || position.x >= size(map)
-            || position.y >= size(map.at(0)))
-            return false;
-
-        if (map[position.x][position.y] != character)
+        if (map[position] != character)
             return false;
 
         position += direction;
@@ -160,4 +134,6 @@ bool match_success(const std::vector<std::string>& map,
     return true;
 }
 
-int main() { solve(parse_from(std::fstream{"data.txt"})); }
+int main(int argc, char* argv[]) {
+    solve(parse_from(std::fstream{argc > 1 ? argv[1] : "data.txt"}));
+}
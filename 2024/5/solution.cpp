@@ -3,41 +3,62 @@
 #include <fstream>
 #include <iostream>
 #include <iterator>
+#include <memory>
+#include <memory_resource>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "../common/arena.hpp"
+#include "../common/instrument.hpp"
+
 struct Data;
 
+using Query         = std::pmr::vector<int>;
+using DependencyMap = std::pmr::unordered_map<int, std::pmr::vector<int>>;
+
 Data             parse_from(std::fstream&&);
 void             solve(Data&&);
 void             solve_q1(const Data&);
 void             solve_q2(const Data&);
-bool             valid_order(const std::vector<int>::const_iterator,
-                             const std::vector<int>::const_iterator,
-                             const std::unordered_map<int, std::vector<int>>&);
-bool             elem_in_valid_order(const std::vector<int>::const_iterator,
-                                     const std::vector<int>::const_iterator,
-                                     const std::unordered_map<int, std::vector<int>>&);
-std::vector<int> valid_reordering(const std::vector<int>::const_iterator,
-                                  const std::vector<int>::const_iterator,
-                                  const std::unordered_map<int, std::vector<int>>&);
-
+bool             valid_order(const Query::const_iterator,
+                             const Query::const_iterator,
+                             const DependencyMap&);
+bool             elem_in_valid_order(const Query::const_iterator,
+                                     const Query::const_iterator,
+                                     const DependencyMap&);
+std::vector<int> valid_reordering(const Query::const_iterator,
+                                  const Query::const_iterator,
+                                  const DependencyMap&);
+
+// Arena bytes per input byte: a rule line of six bytes appends one int to a dependency list, and
+// an update line of three bytes per page becomes an int in a query grown by doubling.
+constexpr std::size_t ARENA_BYTES_PER_INPUT_BYTE = 8;
+
+// The rules and the updates live in `arena`.
 struct Data {
-    std::unordered_map<int, std::vector<int>> dependency;
-    std::vector<std::vector<int>>             queries;
+    std::unique_ptr<Arena>  arena;
+    DependencyMap           dependency;
+    std::pmr::vector<Query> queries;
+
+    Data() = default;
+    explicit Data(std::unique_ptr<Arena> resource) :
+        arena(std::move(resource)),
+        dependency(arena.get()),
+        queries(arena.get()) {}
 
-    Data()                       = default;
     Data(const Data&)            = delete;
     Data& operator=(const Data&) = delete;
     Data(Data&&)                 = default;
-    Data& operator=(Data&&)      = default;
+    Data& operator=(Data&&)      = delete;
 };
 
 Data parse_from(std::fstream&& file) {
-    Data        result;
+    INSTRUMENT_PHASE("parse_from");
+
+    Data        result{make_arena(file, ARENA_BYTES_PER_INPUT_BYTE)};
     std::string line;
 
     while (file >> line)
@@ -52,9 +73,9 @@ Data parse_from(std::fstream&& file) {
 
         else if (line.find(',') != std::string::npos)
         {
-            std::vector<int> this_query;
-            std::size_t      pos;
-            std::string      token;
+            Query       this_query{result.arena.get()};
+            std::size_t pos;
+            std::string token;
 
             while ((pos = line.find(',')) != std::string::npos)
             {
@@ -78,6 +99,8 @@ void solve(Data&& data) {
 }
 
 void solve_q1(const Data& data) {
+    INSTRUMENT_PHASE("solve_q1");
+
     using std::size;
     using std::cbegin;
     using std::cend;
@@ -92,6 +115,8 @@ void solve_q1(const Data& data) {
 }
 
 void solve_q2(const Data& data) {
+    INSTRUMENT_PHASE("solve_q2");
+
     using std::size;
     using std::cbegin;
     using std::cend;
@@ -106,9 +131,9 @@ void solve_q2(const Data& data) {
     std::cout << ans << std::endl;
 }
 
-bool valid_order(const std::vector<int>::const_iterator           it_begin,
-                 const std::vector<int>::const_iterator           it_end,
-                 const std::unordered_map<int, std::vector<int>>& dependency) {
+bool valid_order(const Query::const_iterator it_begin,
+                 const Query::const_iterator it_end,
+                 const DependencyMap&        dependency) {
     for (auto it = it_begin; it != it_end; ++it)
         if (!elem_in_valid_order(it, it_end, dependency))
             return false;
@@ -116,9 +141,9 @@ bool valid_order(const std::vector<int>::const_iterator           it_begin,
     return true;
 }
 
-bool elem_in_valid_order(const std::vector<int>::const_iterator           curr,
-                         const std::vector<int>::const_iterator           end,
-                         const std::unordered_map<int, std::vector<int>>& dependency) {
+bool elem_in_valid_order(const Query::const_iterator curr,
+                         const Query::const_iterator end,
+                         const DependencyMap&        dependency) {
     if (dependency.find(*curr) == dependency.end())
         return true;
 
@@ -129,9 +154,9 @@ bool elem_in_valid_order(const std::vector<int>::const_iterator           curr,
     return true;
 }
 
-std::vector<int> valid_reordering(const std::vector<int>::const_iterator           begin,
-                                  const std::vector<int>::const_iterator           end,
-                                  const std::unordered_map<int, std::vector<int>>& dependencies) {
+std::vector<int> valid_reordering(const Query::const_iterator begin,
+                                  const Query::const_iterator end,
+                                  const DependencyMap&        dependencies) {
     using std::empty;
     using std::cbegin;
     using std::cend;
@@ -160,4 +185,6 @@ std::vector<int> valid_reordering(const std::vector<int>::const_iterator
     return new_query;
 }
 
-int main() { solve(parse_from(std::fstream{"data.txt"})); }
+int main(int argc, char* argv[]) {
+    solve(parse_from(std::fstream{argc > 1 ? argv[1] : "data.txt"}));
+}
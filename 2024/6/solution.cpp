@@ -1,159 +1,231 @@
 #include <array>
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <iterator>
 #include <string>
-#include <unordered_set>
+#include <thread>
+#include <utility>
 #include <vector>
 
-struct Data;
-struct Direction;
-struct Position;
-struct PositionHasher;
-
-Data parse_from(std::fstream&&);
-void solve(Data&&);
-void solve_q1(const Data&);
-void solve_q2(const Data&);
-std::unordered_set<Position, PositionHasher>
-     simulate_walk(const std::vector<std::vector<char>>& map, Position curr_position);
-bool will_halt(const std::vector<std::vector<char>>&, Position, const Position);
-
-constexpr Position  operator+(const Position, const Direction) noexcept;
-constexpr Position& operator+=(Position&, const Direction) noexcept;
-constexpr bool      operator==(const Position rhs, const Position lhs) noexcept;
-
-constexpr Direction operator+(const Direction, const Direction) noexcept;
-constexpr bool      operator==(const Direction rhs, const Direction lhs) noexcept;
-
-struct Direction {
-    int x;
-    int y;
-
-    constexpr Direction(const int a, const int b) :
-        x(a),
-        y(b) {}
-};
+#include "../common/grid.hpp"
+#include "../common/instrument.hpp"
 
-constexpr Direction operator+(const Direction first, const Direction second) noexcept {
-    return Direction(first.x + second.x, first.y + second.y);
+struct Data;
+struct JumpTable;
+struct GuardState;
+struct RouteCell;
+struct VisitedStateDetector;
+struct BrentCycleDetector;
+
+Data                   parse_from(std::fstream&&);
+void                   solve(Data&&);
+void                   solve_q1(const Data&);
+void                   solve_q2(const Data&);
+JumpTable              build_jump_table(const Data&);
+std::vector<RouteCell> simulate_walk(const Data&, const JumpTable&, GuardState);
+bool will_halt(const Data&, const JumpTable&, GuardState, const Position, VisitedStateDetector&);
+
+template<typename Rules, typename CycleDetector>
+bool walk_halts(const Rules&, typename Rules::State, CycleDetector&);
+
+// Directions in the order the guard turns through them, so that turning right is an index
+// increment and a (position, direction) state packs into a flat index.
+constexpr std::array<Direction, 4> CLOCKWISE_DIRECTIONS = ORTHOGONAL_DIRECTIONS;
+
+constexpr std::size_t clockwise(const std::size_t dir_index) noexcept {
+    return (dir_index + 1) % size(CLOCKWISE_DIRECTIONS);
 }
 
-constexpr bool operator==(const Direction lhs, const Direction rhs) noexcept {
-    return lhs.x == rhs.x && lhs.y == rhs.y;
-}
+struct Data {
+    GridBitmap<> obstacles;
+    std::size_t  width;
+    std::size_t  height;
+    Position     start_position;
 
-constexpr Direction N{-1, 0};
-constexpr Direction S{1, 0};
-constexpr Direction E{0, -1};
-constexpr Direction W{0, 1};
+    Data()                       = default;
+    Data(const Data&)            = delete;
+    Data& operator=(const Data&) = delete;
+    Data(Data&&)                 = default;
+    Data& operator=(Data&&)      = default;
+};
 
-constexpr std::array<Direction, 4> ALL_DIRECTIONS{N, S, E, W};
+// For every free cell and direction, the last cell the guard reaches before the next obstacle or
+// the edge of the map, so a walk advances one straight segment at a time.
+struct JumpTable {
+    std::vector<Position> stops;
+    std::size_t           width;
+    std::size_t           area;
 
-struct Position {
-    int x;
-    int y;
+    Position stop(const Position pos, const std::size_t dir_index) const noexcept {
+        return stops[dir_index * area + flat_index(pos, width)];
+    }
 };
 
-struct PositionHasher {
-    constexpr PositionHasher(size_t w) :
-        width(w) {}
-
-    constexpr size_t operator()(const Position& pos) const { return pos.x * width + pos.y; }
+struct GuardState {
+    Position    position;
+    std::size_t direction;
+};
 
-   private:
-    size_t width;
+// A cell on the guard's original route, together with the state the guard was in just before
+// first stepping onto it. Any walk with a blocker on that cell is identical up to that state.
+struct RouteCell {
+    Position   position;
+    GuardState entered_from;
 };
 
-struct DirectedPosition {
-    Position  pos;
-    Direction dir;
+// Cycle detectors observe the dense indices of the states a walker passes through and report
+// whether one has repeated. `reset` starts a new walk.
+
+// Epoch-stamped table over the whole state space, reusable across walks without clearing: a state
+// counts as visited only if it was stamped during the current epoch. Memory is fixed at one word
+// per state and a cycle is reported on the first repeated state.
+struct VisitedStateDetector {
+    std::vector<std::uint32_t> stamps;
+    std::uint32_t              epoch = 0;
+
+    explicit VisitedStateDetector(const std::size_t num_states) :
+        stamps(num_states) {}
+
+    void reset() {
+        if (++epoch == 0)
+        {
+            std::fill(begin(stamps), end(stamps), 0);
+            epoch = 1;
+        }
+    }
+
+    bool observe(const std::size_t state) noexcept {
+        if (stamps[state] == epoch)
+            return true;
+
+        stamps[state] = epoch;
+        return false;
+    }
 };
 
-struct DirectedPositionHasher {
-    constexpr DirectedPositionHasher(size_t w, size_t h) :
-        width(w),
-        height(h) {}
+// Brent's algorithm: constant memory regardless of the state space, at the cost of walking up to
+// about twice the cycle length past the first repeated state. Suited to rule sets whose state
+// space is too large to tabulate.
+struct BrentCycleDetector {
+    std::size_t tortoise;
+    std::size_t power;
+    std::size_t length;
 
-    constexpr size_t operator()(const DirectedPosition& dpos) const {
-        int dir_index = 0;
+    explicit BrentCycleDetector(const std::size_t = 0) { reset(); }
 
-        if (dpos.dir == N)
-            dir_index = 0;
+    void reset() noexcept {
+        tortoise = static_cast<std::size_t>(-1);
+        power = length = 1;
+    }
 
-        else if (dpos.dir == E)
-            dir_index = 1;
+    bool observe(const std::size_t state) noexcept {
+        if (state == tortoise)
+            return true;
 
-        else if (dpos.dir == S)
-            dir_index = 2;
+        if (length == power)
+        {
+            tortoise = state;
+            power *= 2;
+            length = 0;
+        }
 
-        else if (dpos.dir == W)
-            dir_index = 3;
+        length++;
+        return false;
+    }
+};
 
-        return dir_index * width * height + dpos.pos.x * width + dpos.pos.y;
+// Turning policies map the direction a walker faces on hitting an obstacle to its new direction.
+struct TurnRight {
+    static constexpr std::size_t turn(const std::size_t dir_index) noexcept {
+        return clockwise(dir_index);
     }
+};
 
-   private:
-    size_t width;
-    size_t height;
+struct TurnLeft {
+    static constexpr std::size_t turn(const std::size_t dir_index) noexcept {
+        return (dir_index + size(CLOCKWISE_DIRECTIONS) - 1) % size(CLOCKWISE_DIRECTIONS);
+    }
 };
 
-constexpr bool operator==(const Position lhs, const Position rhs) noexcept {
-    return lhs.x == rhs.x && lhs.y == rhs.y;
-}
+struct TurnAround {
+    static constexpr std::size_t turn(const std::size_t dir_index) noexcept {
+        return (dir_index + 2) % size(CLOCKWISE_DIRECTIONS);
+    }
+};
 
-constexpr Position operator+(const Position pos, const Direction direction) noexcept {
-    return Position{pos.x + direction.x, pos.y + direction.y};
-}
+// Movement rules for a walker that moves straight until it hits an obstacle or an extra blocker,
+// then turns according to `TurnPolicy`. Rule sets expose the interface used by `walk_halts`:
+// a `State` type, the size of the dense state space, the dense index of a state, and `advance`,
+// which moves to the next state worth recording and returns false once the walker leaves the map.
+template<typename TurnPolicy>
+struct BlockedWalkRules {
+    using State = GuardState;
 
-constexpr Position& operator+=(Position& pos, const Direction direction) noexcept {
-    pos.x += direction.x;
-    pos.y += direction.y;
-    return pos;
-}
+    const Data&      data;
+    const JumpTable& jumps;
+    Position         blocker;
 
-constexpr bool operator==(const DirectedPosition lhs, const DirectedPosition rhs) noexcept {
-    return lhs.pos == rhs.pos && lhs.dir == rhs.dir;
-}
+    std::size_t num_states() const noexcept {
+        return size(CLOCKWISE_DIRECTIONS) * data.width * data.height;
+    }
 
-constexpr Direction clockwise(const Direction dir) noexcept { return Direction{dir.y, -dir.x}; }
+    std::size_t index(const State state) const noexcept {
+        return state.direction * data.width * data.height + flat_index(state.position, data.width);
+    }
 
-struct Data {
-    std::vector<std::vector<char>> map;
-    Position                       start_position;
+    bool advance(State& state) const noexcept {
+        const Direction dir  = CLOCKWISE_DIRECTIONS[state.direction];
+        Position        stop = jumps.stop(state.position, state.direction);
 
-    Data()                       = default;
-    Data(const Data&)            = delete;
-    Data& operator=(const Data&) = delete;
-    Data(Data&&)                 = default;
-    Data& operator=(Data&&)      = default;
+        // The blocker only matters if it lies on the segment about to be walked.
+        const Direction to_blocker = blocker - state.position;
+        const int       distance   = dot(to_blocker, dir);
+
+        if (cross(to_blocker, dir) == 0 && distance > 0
+            && distance <= dot(stop - state.position, dir))
+            stop = state.position + dir * (distance - 1);
+
+        else if (!in_bounds(stop + dir, data.height, data.width))
+            return false;
+
+        state.position  = stop;
+        state.direction = TurnPolicy::turn(state.direction);
+        return true;
+    }
 };
 
+// The guard of the puzzle, walking with one extra obstruction.
+using GuardRules = BlockedWalkRules<TurnRight>;
+
 Data parse_from(std::fstream&& file) {
-    using std::begin;
-    using std::end;
-    using std::cbegin;
-    using std::cend;
+    INSTRUMENT_PHASE("parse_from");
 
-    Data        result;
-    std::string line;
+    using std::size;
+
+    Data                     result;
+    std::string              line;
+    std::vector<std::string> lines;
 
     while (file >> line)
-    {
-        result.map.emplace_back(cbegin(line), cend(line));
-        auto start_loc = std::find(begin(result.map.back()), end(result.map.back()), '^');
+        lines.push_back(std::move(line));
+
+    result.height    = size(lines);
+    result.width     = lines.empty() ? 0 : size(lines[0]);
+    result.obstacles = GridBitmap<>{result.height, result.width};
 
-        if (start_loc != end(result.map.back()))
+    for (int x = 0; x < size(lines); x++)
+        for (int y = 0; y < size(lines[x]); y++)
         {
-            result.start_position =
-              Position{static_cast<int>(size(result.map) - 1),
-                       static_cast<int>(std::distance(begin(result.map.back()), start_loc))};
+            if (lines[x][y] == '#')
+                result.obstacles.insert(Position{x, y});
 
-            *start_loc = '.';
+            if (lines[x][y] == '^')
+                result.start_position = Position{x, y};
         }
-    }
 
     return result;
 }
@@ -164,87 +236,152 @@ void solve(Data&& data) {
 }
 
 void solve_q1(const Data& data) {
+    INSTRUMENT_PHASE("solve_q1");
+
     using std::size;
-    std::cout << size(simulate_walk(data.map, data.start_position)) << std::endl;
+
+    const auto route =
+      simulate_walk(data, build_jump_table(data), GuardState{data.start_position, 0});
+    std::cout << size(route) << std::endl;
 }
 
 void solve_q2(const Data& data) {
+    INSTRUMENT_PHASE("solve_q2");
+
     using std::size;
 
-    int ans = 0;
+    const auto jumps = build_jump_table(data);
+    const auto route = simulate_walk(data, jumps, GuardState{data.start_position, 0});
 
-    auto relevant_positions = simulate_walk(data.map, data.start_position);
-    relevant_positions.erase(data.start_position);
+    // Every blocker position walks the same state space.
+    const std::size_t num_states = GuardRules{data, jumps, data.start_position}.num_states();
 
-    for (const auto blocker : relevant_positions)
-    {
-        if (!will_halt(data.map, data.start_position, blocker))
-            ans++;
-    }
+    constexpr std::size_t CHUNK_SIZE = 64;
 
-    std::cout << ans << std::endl;
-}
+    const std::size_t num_threads =
+      std::max<std::size_t>(1, std::min<std::size_t>(std::thread::hardware_concurrency(),
+                                                     size(route) / CHUNK_SIZE + 1));
 
-std::unordered_set<Position, PositionHasher>
-simulate_walk(const std::vector<std::vector<char>>& map, Position curr_position) {
-    using std::size;
+    // The first route cell is the starting position, where no blocker may be placed.
+    std::atomic<std::size_t> next_candidate{1};
+    std::atomic<int>         ans{0};
 
-    Direction curr_direction = N;
+    const auto worker = [&]() {
+        VisitedStateDetector visited{num_states};
+        int                  loops = 0;
 
-    std::unordered_set<Position, PositionHasher> visited{11, PositionHasher(size(map[0]))};
+        for (std::size_t begin = next_candidate.fetch_add(CHUNK_SIZE); begin < size(route);
+             begin             = next_candidate.fetch_add(CHUNK_SIZE))
+        {
+            const std::size_t end = std::min(begin + CHUNK_SIZE, size(route));
 
-    while (true)
-    {
-        const Position next_position = curr_position + curr_direction;
+            for (std::size_t i = begin; i < end; i++)
+                if (!will_halt(data, jumps, route[i].entered_from, route[i].position, visited))
+                    loops++;
+        }
 
-        visited.insert(curr_position);
+        ans += loops;
+    };
 
-        if (next_position.x < 0 || next_position.y < 0 || next_position.x >= size(map)
-            || next_position.y >= size(map[0]))
-            return visited;
+    std::vector<std::thread> workers;
 
-        if (map[next_position.x][next_position.y] == '#')
-        {
-            curr_direction = clockwise(curr_direction);
-            continue;
-        }
+    for (std::size_t i = 1; i < num_threads; i++)
+        workers.emplace_back(worker);
 
-        curr_position += curr_direction;
+    worker();
+
+    for (auto& thread : workers)
+        thread.join();
+
+    std::cout << ans << std::endl;
+}
+
+JumpTable build_jump_table(const Data& data) {
+    const std::size_t area = data.width * data.height;
+    JumpTable         result{std::vector<Position>(size(CLOCKWISE_DIRECTIONS) * area), data.width,
+                     area};
+
+    for (std::size_t dir_index = 0; dir_index < size(CLOCKWISE_DIRECTIONS); dir_index++)
+    {
+        const Direction dir = CLOCKWISE_DIRECTIONS[dir_index];
+
+        // Visit cells so that the neighbour in direction `dir` is always resolved first.
+        const int x_begin = dir.x > 0 ? data.height - 1 : 0;
+        const int x_step  = dir.x > 0 ? -1 : 1;
+        const int y_begin = dir.y > 0 ? data.width - 1 : 0;
+        const int y_step  = dir.y > 0 ? -1 : 1;
+
+        for (int x = x_begin; x >= 0 && x < data.height; x += x_step)
+            for (int y = y_begin; y >= 0 && y < data.width; y += y_step)
+            {
+                const Position curr = Position{x, y};
+                const Position next = curr + dir;
+
+                result.stops[dir_index * area + flat_index(curr, data.width)] =
+                  !in_bounds(next, data.height, data.width) || data.obstacles.contains(next)
+                    ? curr
+                    : result.stop(next, dir_index);
+            }
     }
+
+    return result;
 }
 
-bool will_halt(const std::vector<std::vector<char>>& map,
-               Position                              curr_position,
-               const Position                        blocker) {
-    using std::size;
+std::vector<RouteCell>
+simulate_walk(const Data& data, const JumpTable& jumps, const GuardState start) {
+    GridBitmap<>           visited{data.height, data.width};
+    std::vector<RouteCell> route{RouteCell{start.position, start}};
+    GuardState             curr = start;
 
-    Direction                                                    curr_direction = N;
-    std::unordered_set<DirectedPosition, DirectedPositionHasher> lookup{
-      11, DirectedPositionHasher(size(map[0]), size(map))};
-    std::unordered_set<Position, PositionHasher> visited{11, PositionHasher(size(map[0]))};
+    visited.insert(start.position);
 
     while (true)
     {
-        if (lookup.find(DirectedPosition{curr_position, curr_direction}) != lookup.end())
-            return false;
+        const Direction dir  = CLOCKWISE_DIRECTIONS[curr.direction];
+        const Position  stop = jumps.stop(curr.position, curr.direction);
 
-        lookup.insert(DirectedPosition{curr_position, curr_direction});
+        for (; curr.position != stop; curr.position += dir)
+        {
+            const Position next = curr.position + dir;
 
-        const Position next_position = curr_position + curr_direction;
+            if (visited.insert(next))
+                route.push_back(RouteCell{next, curr});
+        }
 
-        if (next_position.x < 0 || next_position.y < 0 || next_position.x >= size(map)
-            || next_position.y >= size(map[next_position.x]))
-            return true;
+        if (!in_bounds(stop + dir, data.height, data.width))
+            return route;
 
-        if (map[next_position.x][next_position.y] == '#' || next_position == blocker)
-        {
-            curr_direction = clockwise(curr_direction);
-            continue;
-        }
+        curr.direction = clockwise(curr.direction);
+    }
+}
+
+template<typename Rules, typename CycleDetector>
+bool walk_halts(const Rules& rules, typename Rules::State state, CycleDetector& detector) {
+    detector.reset();
+
+    // Only the states produced by `advance` are recorded; revisiting one means a loop.
+    while (rules.advance(state))
+    {
+        INSTRUMENT_COUNT("walk segments", 1);
 
-        curr_position += curr_direction;
+        if (detector.observe(rules.index(state)))
+            return false;
     }
+
+    return true;
+}
+
+bool will_halt(const Data&           data,
+               const JumpTable&      jumps,
+               const GuardState      start,
+               const Position        blocker,
+               VisitedStateDetector& detector) {
+    INSTRUMENT_SCOPE("will_halt");
+
+    return walk_halts(GuardRules{data, jumps, blocker}, start, detector);
 }
 
 
-int main() { solve(parse_from(std::fstream{"data.txt"})); }
+int main(int argc, char* argv[]) {
+    solve(parse_from(std::fstream{argc > 1 ? argv[1] : "data.txt"}));
+}
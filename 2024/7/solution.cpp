@@ -1,18 +1,32 @@
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cctype>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <deque>
 #include <fstream>
 #include <iostream>
 #include <iterator>
 #include <limits>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "../common/dispatch.hpp"
+#include "../common/instrument.hpp"
+
 struct Data;
+struct SearchTask;
+class WorkStealingQueue;
+class ReachableSetCache;
 
 Data parse_from(std::fstream&&);
 void solve(Data&&);
@@ -25,6 +39,32 @@ bool is_possible(const T, Iterator, Iterator, Ops...);
 template<typename Iterator, typename T, typename... Ops>
 bool search_for_possible(const T, const T, const Iterator, const Iterator, Ops...);
 
+template<typename Iterator, typename T, typename... Ops>
+bool is_possible_backwards(const T, Iterator, Iterator, Ops...);
+
+template<typename Iterator, typename T, typename... Ops>
+bool search_backwards(const T, const Iterator, const Iterator, Ops...);
+
+using uint128_t = unsigned __int128;
+
+// Four 64-bit lanes; GCC lowers operations to whatever vector width the target supports.
+using u64x4 = std::uint64_t __attribute__((vector_size(32)));
+
+template<typename T>
+struct is_unsigned_integer;
+
+template<typename T>
+constexpr T saturating_add(const T, const T) noexcept;
+
+template<typename T>
+constexpr T saturating_multiply(const T, const T) noexcept;
+
+template<typename T>
+constexpr T append_digit(const T, const char) noexcept;
+
+template<typename T>
+std::string to_decimal(T);
+
 template<typename T>
 constexpr T power(const T base, const std::size_t exponent);
 
@@ -35,6 +75,80 @@ template<typename T, std::size_t... Is>
 constexpr std::array<T, sizeof...(Is)>
 make_power_sequence(T base, std::integer_sequence<std::size_t, Is...>);
 
+// Unsigned integers the operators accept, including `uint128_t`, which `std::is_integral` does not
+// report under strict -std=c++17.
+template<typename T>
+struct is_unsigned_integer: std::bool_constant<std::is_integral_v<T> && std::is_unsigned_v<T>> {};
+
+template<>
+struct is_unsigned_integer<uint128_t>: std::true_type {};
+
+template<typename T>
+constexpr bool is_unsigned_integer_v = is_unsigned_integer<T>::value;
+
+// Saturating arithmetic: results that do not fit in `T` become `std::numeric_limits<T>::max()`,
+// which the `cur > target` prune discards for every representable target below it. A target of
+// exactly that maximum would be indistinguishable from an overflow, so the parser rejects it along
+// with every larger number. Types narrower than 128 bits compute the exact result in `uint128_t`
+// and clamp it; `uint128_t` itself relies on the overflow-checking builtins.
+template<typename T>
+constexpr T saturating_add(const T a, const T b) noexcept {
+    static_assert(is_unsigned_integer_v<T>);
+
+    T result{};
+
+    if (__builtin_add_overflow(a, b, &result))
+        return std::numeric_limits<T>::max();
+
+    return result;
+}
+
+template<typename T>
+constexpr T saturating_multiply(const T a, const T b) noexcept {
+    static_assert(is_unsigned_integer_v<T>);
+
+    if constexpr (sizeof(T) < sizeof(uint128_t))
+    {
+        const uint128_t wide = static_cast<uint128_t>(a) * b;
+        return wide > std::numeric_limits<T>::max() ? std::numeric_limits<T>::max()
+                                                    : static_cast<T>(wide);
+    }
+
+    else
+    {
+        T result{};
+
+        if (__builtin_mul_overflow(a, b, &result))
+            return std::numeric_limits<T>::max();
+
+        return result;
+    }
+}
+
+// `value` with the decimal digit `digit` appended, saturating like the operators.
+template<typename T>
+constexpr T append_digit(const T value, const char digit) noexcept {
+    const T shifted = saturating_multiply(value, static_cast<T>(10));
+    return saturating_add(shifted, static_cast<T>(digit - '0'));
+}
+
+// `std::ostream` has no overload for `uint128_t`.
+template<typename T>
+std::string to_decimal(T num) {
+    static_assert(is_unsigned_integer_v<T>);
+
+    std::string result;
+
+    do
+    {
+        result.push_back('0' + static_cast<int>(num % 10));
+        num /= 10;
+    } while (num);
+
+    std::reverse(begin(result), end(result));
+    return result;
+}
+
 template<typename T>
 constexpr T power(const T base, const std::size_t exponent) {
     if (exponent == 0)
@@ -67,7 +181,7 @@ make_power_sequence(T base, std::integer_sequence<std::size_t, Is...>) {
 
 template<typename T>
 struct Extended {
-    static_assert(std::is_integral_v<T>);
+    static_assert(is_unsigned_integer_v<T>);
     T           value;
     std::size_t num_digits;
 
@@ -80,38 +194,98 @@ struct Extended {
 
 template<typename T>
 struct extended_plus {
-    static_assert(std::is_integral_v<T>);
+    static_assert(is_unsigned_integer_v<T>);
+
+    T operator()(const T a, const T b) const noexcept { return saturating_add(a, b); }
+    T operator()(const T a, const Extended<T> b) const noexcept {
+        return saturating_add(a, static_cast<T>(b));
+    }
+
+    // The `a` for which `a + b == result`, if any.
+    std::optional<T> undo(const T result, const Extended<T> b) const noexcept {
+        if (result < static_cast<T>(b))
+            return std::nullopt;
+
+        return result - static_cast<T>(b);
+    }
+
+    // Unchecked lane-wise application; `factor(b) * max(a) + b` must fit in `T`.
+    template<typename V>
+    void apply_to_lanes(V& a, const Extended<T> b) const noexcept {
+        a = a + static_cast<T>(b);
+    }
 
-    T operator()(const T a, const T b) const noexcept { return a + b; }
-    T operator()(const T a, const Extended<T> b) const noexcept { return a + static_cast<T>(b); }
+    T factor(const Extended<T>) const noexcept { return 1; }
 };
 
 
 template<typename T>
 struct extended_multiplies {
-    static_assert(std::is_integral_v<T>);
+    static_assert(is_unsigned_integer_v<T>);
+
+    T operator()(const T a, const T b) const noexcept { return saturating_multiply(a, b); }
+    T operator()(const T a, const Extended<T> b) const noexcept {
+        return saturating_multiply(a, static_cast<T>(b));
+    }
+
+    // The `a` for which `a * b == result`, if any. A zero `b` does not determine `a`, so callers
+    // must not undo multiplication by zero.
+    std::optional<T> undo(const T result, const Extended<T> b) const noexcept {
+        if (result % static_cast<T>(b) != 0)
+            return std::nullopt;
+
+        return result / static_cast<T>(b);
+    }
+
+    template<typename V>
+    void apply_to_lanes(V& a, const Extended<T> b) const noexcept {
+        a = a * static_cast<T>(b);
+    }
 
-    T operator()(const T a, const T b) const noexcept { return a * b; }
-    T operator()(const T a, const Extended<T> b) const noexcept { return a * static_cast<T>(b); }
+    T factor(const Extended<T> b) const noexcept { return static_cast<T>(b); }
 };
 
 
 template<typename T>
 struct extended_concatenate {
-    static_assert(std::is_integral_v<T>);
+    static_assert(is_unsigned_integer_v<T>);
 
     static constexpr std::array<T, num_digits(std::numeric_limits<T>::max())> LOOKUP =
       make_power_sequence<T>(
         10, std::make_integer_sequence<std::size_t, num_digits(std::numeric_limits<T>::max())>());
 
-    T operator()(const T a, const T b) const noexcept { return a * LOOKUP[num_digits(b)] + b; }
+    T operator()(const T a, const T b) const noexcept {
+        return saturating_add(saturating_multiply(a, LOOKUP[num_digits(b)]), b);
+    }
     T operator()(const T a, const Extended<T> b) const noexcept {
-        return a * LOOKUP[b.num_digits] + static_cast<T>(b);
+        return saturating_add(saturating_multiply(a, LOOKUP[b.num_digits]), static_cast<T>(b));
+    }
+
+    // The `a` for which `a || b == result`, i.e. `result` with the digits of `b` stripped, if any.
+    std::optional<T> undo(const T result, const Extended<T> b) const noexcept {
+        if (result < static_cast<T>(b) || (result - static_cast<T>(b)) % LOOKUP[b.num_digits] != 0)
+            return std::nullopt;
+
+        return (result - static_cast<T>(b)) / LOOKUP[b.num_digits];
+    }
+
+    template<typename V>
+    void apply_to_lanes(V& a, const Extended<T> b) const noexcept {
+        a = a * LOOKUP[b.num_digits] + static_cast<T>(b);
     }
+
+    T factor(const Extended<T> b) const noexcept { return LOOKUP[b.num_digits]; }
 };
 
 struct Data {
-    std::vector<std::pair<std::uint64_t, std::vector<Extended<std::uint64_t>>>> data;
+    // Wide enough for every target in the input; AOC_DAY7_WIDE switches to `uint128_t`.
+#ifdef AOC_DAY7_WIDE
+    using value_type = uint128_t;
+#else
+    using value_type = std::uint64_t;
+#endif
+
+    std::vector<std::pair<value_type, std::vector<Extended<value_type>>>> data;
 
     Data()                       = default;
     Data(const Data&)            = delete;
@@ -120,20 +294,227 @@ struct Data {
     Data& operator=(Data&&)      = default;
 };
 
+enum class Evaluator {
+    BackwardsSearch,
+    ReachableSets,
+    Vectorized,
+};
+
+template<typename... Ops>
+Data::value_type sum_possible(const Data&, Ops...);
+
+template<typename... Ops>
+Data::value_type sum_possible_parallel(const Data&, const std::size_t, Ops...);
+
+template<typename... Ops>
+Data::value_type sum_possible_reachable(const Data&, Ops...);
+
+template<typename... Ops>
+Data::value_type sum_possible_vectorized(const Data&, Ops...);
+
+template<typename T, typename... Ops>
+std::optional<bool> is_possible_vectorized(const T, const std::vector<Extended<T>>&, Ops...);
+
+// The backwards search prunes far more than forward enumeration on typical rows; the reachable-set
+// evaluator wins when many rows share long operand prefixes, and the vectorized evaluator when
+// rows are short and rarely prunable. Select one with -DAOC_DAY7_EVALUATOR=ReachableSets, say.
+#ifndef AOC_DAY7_EVALUATOR
+    #define AOC_DAY7_EVALUATOR BackwardsSearch
+#endif
+
+constexpr Evaluator EVALUATOR = Evaluator::AOC_DAY7_EVALUATOR;
+
+// Rows with more operator combinations than this are left to the backwards search.
+constexpr std::size_t VECTORIZED_MAX_COMBINATIONS = 1 << 14;
+
+// Number of operators undone breadth-first as separate tasks before a subtree is searched
+// recursively by a single worker. Deeper splits balance rows of very uneven cost at the price of
+// more queue traffic.
+constexpr std::size_t SPLIT_DEPTH = 3;
+
+// A subtree of the backwards search: row `row` is satisfiable from here if the operands up to and
+// including index `last` can produce `remaining`.
+struct SearchTask {
+    std::size_t      row;
+    Data::value_type remaining;
+    std::size_t      last;
+};
+
+// Per-worker task deque. The owner pushes and pops at the back, keeping its recently split
+// subtrees hot; idle workers steal the oldest, usually largest, subtrees from the front.
+class WorkStealingQueue {
+   public:
+    void push(const SearchTask task) {
+        std::lock_guard lock{mutex};
+        tasks.push_back(task);
+    }
+
+    std::optional<SearchTask> pop() {
+        std::lock_guard lock{mutex};
+
+        if (tasks.empty())
+            return std::nullopt;
+
+        const SearchTask task = tasks.back();
+        tasks.pop_back();
+        return task;
+    }
+
+    std::optional<SearchTask> steal() {
+        std::lock_guard lock{mutex};
+
+        if (tasks.empty())
+            return std::nullopt;
+
+        const SearchTask task = tasks.front();
+        tasks.pop_front();
+        return task;
+    }
+
+   private:
+    std::mutex             mutex;
+    std::deque<SearchTask> tasks;
+};
+
+// Trie over the operand prefixes of all rows. A node stores the sorted, deduplicated set of values
+// reachable from its prefix, bounded by the largest target of the rows passing through it, but
+// only if more than one row passes through it; unshared suffixes are evaluated without caching.
+class ReachableSetCache {
+   public:
+    using T = Data::value_type;
+
+    explicit ReachableSetCache(const Data& data) {
+        nodes.emplace_back();
+
+        for (const auto& [target, operands] : data.data)
+        {
+            std::size_t node = ROOT;
+
+            for (const auto operand : operands)
+            {
+                const auto [it, inserted] =
+                  nodes[node].children.try_emplace(key(operand), size(nodes));
+
+                if (inserted)
+                    nodes.emplace_back();
+
+                node = it->second;
+                nodes[node].uses++;
+                nodes[node].bound = std::max(nodes[node].bound, target);
+            }
+        }
+    }
+
+    template<typename... Ops>
+    bool is_reachable(const T target, const std::vector<Extended<T>>& operands, Ops... ops) {
+        if (operands.empty())
+            return false;
+
+        const std::vector<T>* reachable = &local;
+        std::size_t           node      = ROOT;
+
+        for (std::size_t i = 0; i < size(operands); i++)
+        {
+            const std::size_t parent = node;
+            node                     = nodes[parent].children.at(key(operands[i]));
+
+            if (nodes[node].uses < 2)
+            {
+                extend(i == 0 ? nullptr : reachable, operands[i], target, scratch, ops...);
+                std::swap(local, scratch);
+                reachable = &local;
+            }
+
+            else
+            {
+                if (!nodes[node].computed)
+                {
+                    extend(i == 0 ? nullptr : reachable, operands[i], nodes[node].bound,
+                           nodes[node].reachable, ops...);
+                    nodes[node].computed = true;
+                }
+
+                reachable = &nodes[node].reachable;
+            }
+        }
+
+        return std::binary_search(cbegin(*reachable), cend(*reachable), target);
+    }
+
+   private:
+    static constexpr std::size_t ROOT = 0;
+
+    struct Node {
+        std::map<std::pair<T, std::size_t>, std::size_t> children;
+        std::vector<T>                                   reachable;
+        T                                                bound    = 0;
+        std::size_t                                      uses     = 0;
+        bool                                             computed = false;
+    };
+
+    static std::pair<T, std::size_t> key(const Extended<T> operand) {
+        return {static_cast<T>(operand), operand.num_digits};
+    }
+
+    // Applies every operator with `operand` to each value in `previous` (or starts from `operand`
+    // itself for the first level), dropping values above `bound`.
+    template<typename... Ops>
+    static void extend(const std::vector<T>* previous,
+                       const Extended<T>     operand,
+                       const T               bound,
+                       std::vector<T>&       next,
+                       Ops... ops) {
+        next.clear();
+
+        if (!previous)
+        {
+            if (static_cast<T>(operand) <= bound)
+                next.push_back(static_cast<T>(operand));
+        }
+
+        else
+            for (const T value : *previous)
+            {
+                const auto apply = [&](const auto op) {
+                    const T result = op(value, operand);
+
+                    if (result <= bound)
+                        next.push_back(result);
+                };
+
+                (apply(ops), ...);
+            }
+
+        std::sort(begin(next), end(next));
+        next.erase(std::unique(begin(next), end(next)), end(next));
+    }
+
+    std::vector<Node> nodes;
+    std::vector<T>    local;
+    std::vector<T>    scratch;
+};
+
 Data parse_from(std::fstream&& file) {
+    INSTRUMENT_PHASE("parse_from");
+
     using std::size;
 
-    Data                                 result;
-    std::string                          line;
-    std::vector<Extended<std::uint64_t>> resources;
+    using T = Data::value_type;
+
+    Data                     result;
+    std::string              line;
+    std::vector<Extended<T>> resources;
 
     while (std::getline(file, line))
     {
-        std::size_t pos = 0;
+        std::size_t pos    = 0;
+        T           target = 0;
+
+        for (; pos < size(line) && std::isdigit(line[pos]); pos++)
+            target = append_digit(target, line[pos]);
 
-        const std::uint64_t target = std::stoull(line, &pos);
-        std::uint64_t       temp   = 0;
-        std::size_t         len    = 0;
+        T           temp = 0;
+        std::size_t len  = 0;
 
         for (size_t i = pos + 2; i < size(line); i++)
         {
@@ -145,13 +526,20 @@ Data parse_from(std::fstream&& file) {
 
             else
             {
-                temp *= 10;
-                temp += line[i] - '0';
+                temp = append_digit(temp, line[i]);
                 len++;
             }
         }
 
         resources.emplace_back(temp, len);
+
+        // Saturated numbers did not fit; with them the sums would silently be wrong.
+        if (target == std::numeric_limits<T>::max()
+            || std::any_of(cbegin(resources), cend(resources), [](const auto operand) {
+                   return static_cast<T>(operand) == std::numeric_limits<T>::max();
+               }))
+            throw std::overflow_error("number too large for Data::value_type (see AOC_DAY7_WIDE): "
+                                      + line);
         result.data.emplace_back(target, std::move(resources));
         resources.clear();
     }
@@ -165,35 +553,35 @@ void solve(Data&& data) {
 }
 
 void solve_q1(const Data& data) {
+    INSTRUMENT_PHASE("solve_q1");
+
     using std::cbegin;
     using std::cend;
 
-    std::uint64_t ans = 0;
-    for (const auto& row : data.data)
-        if (is_possible(row.first, cbegin(row.second), cend(row.second),
-                        extended_multiplies<std::uint64_t>{}, extended_plus<std::uint64_t>{}))
-            ans += row.first;
+    using T = Data::value_type;
 
-    std::cout << ans << std::endl;
+    std::cout << to_decimal(sum_possible(data, extended_multiplies<T>{}, extended_plus<T>{}))
+              << std::endl;
 }
 
 void solve_q2(const Data& data) {
+    INSTRUMENT_PHASE("solve_q2");
+
     using std::cbegin;
     using std::cend;
 
-    std::uint64_t ans = 0;
-    for (const auto& row : data.data)
-        if (is_possible(row.first, cbegin(row.second), cend(row.second),
-                        extended_concatenate<std::uint64_t>{}, extended_multiplies<std::uint64_t>{},
-                        extended_plus<std::uint64_t>{}))
-            ans += row.first;
+    using T = Data::value_type;
 
-    std::cout << ans << std::endl;
+    std::cout << to_decimal(sum_possible(data, extended_concatenate<T>{}, extended_multiplies<T>{},
+                                         extended_plus<T>{}))
+              << std::endl;
 }
 
 template<typename Iterator, typename T, typename... Ops>
 bool search_for_possible(
   const T target, const T cur, const Iterator next_element, const Iterator end, Ops... ops) {
+    INSTRUMENT_COUNT("search nodes", 1);
+
     if (cur > target)
         return false;
 
@@ -215,4 +603,291 @@ bool is_possible(const T target, const Iterator begin, const Iterator end, Ops..
     return search_for_possible(target, static_cast<T>(*begin), std::next(begin), end, ops...);
 }
 
-int main() { solve(parse_from(std::fstream{"data.txt"})); }
+// Runs the equation from the target back towards the first operand, undoing each operator on the
+// last remaining operand. Operators that cannot be undone exactly (a subtraction below zero, an
+// inexact division, a suffix that does not match) prune the branch immediately.
+template<typename Iterator, typename T, typename... Ops>
+bool search_backwards(const T remaining, const Iterator begin, const Iterator last, Ops... ops) {
+    INSTRUMENT_COUNT("search nodes", 1);
+
+    if (last == begin)
+        return remaining == static_cast<T>(*begin);
+
+    const auto undo_and_search = [&](const auto op) {
+        const std::optional<T> previous = op.undo(remaining, *last);
+        return previous && search_backwards(*previous, begin, std::prev(last), ops...);
+    };
+
+    return (undo_and_search(ops) || ...);
+}
+
+template<typename Iterator, typename T, typename... Ops>
+bool is_possible_backwards(const T target, const Iterator begin, const Iterator end, Ops... ops) {
+    if (begin == end)
+        return false;
+
+    static_assert(sizeof...(ops) >= 1);
+
+    // Multiplication by zero cannot be undone, so such rows are searched forwards instead.
+    if (std::any_of(std::next(begin), end, [](const auto operand) {
+            return static_cast<T>(operand) == 0;
+        }))
+        return is_possible(target, begin, end, ops...);
+
+    return search_backwards(target, begin, std::prev(end), ops...);
+}
+
+template<typename... Ops>
+Data::value_type sum_possible(const Data& data, Ops... ops) {
+    if constexpr (EVALUATOR == Evaluator::ReachableSets)
+        return sum_possible_reachable(data, ops...);
+
+    else if constexpr (EVALUATOR == Evaluator::Vectorized)
+        return sum_possible_vectorized(data, ops...);
+
+    else
+        return sum_possible_parallel(data, SPLIT_DEPTH, ops...);
+}
+
+// Sums the targets of all satisfiable rows. Rows are dealt round-robin to per-thread queues and
+// the first `split_depth` levels of each row's backwards search are expanded into separate tasks,
+// so idle workers can steal parts of an expensive row instead of waiting for its owner.
+template<typename... Ops>
+Data::value_type
+sum_possible_parallel(const Data& data, const std::size_t split_depth, Ops... ops) {
+    using std::cbegin;
+    using std::size;
+    using T = Data::value_type;
+
+    const std::size_t num_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<WorkStealingQueue> queues(num_threads);
+    std::vector<std::atomic<bool>> found(size(data.data));
+    std::atomic<std::size_t>       pending{0};
+
+    for (std::size_t i = 0; i < size(data.data); i++)
+        if (!data.data[i].second.empty())
+        {
+            queues[i % num_threads].push(
+              SearchTask{i, data.data[i].first, size(data.data[i].second) - 1});
+            pending++;
+        }
+
+    const auto run = [&](WorkStealingQueue& own, const SearchTask task) {
+        const auto& [target, operands] = data.data[task.row];
+        const auto first               = cbegin(operands);
+
+        if (found[task.row])
+            return;
+
+        const std::size_t depth = size(operands) - 1 - task.last;
+
+        // Rows that must fall back to the forward search are not split.
+        if (depth == 0
+            && std::any_of(std::next(first), cend(operands),
+                           [](const auto operand) { return static_cast<T>(operand) == 0; }))
+        {
+            if (is_possible_backwards(target, first, cend(operands), ops...))
+                found[task.row] = true;
+        }
+
+        else if (task.last == 0 || depth >= split_depth)
+        {
+            if (search_backwards(task.remaining, first, std::next(first, task.last), ops...))
+                found[task.row] = true;
+        }
+
+        else
+        {
+            const auto split = [&](const auto op) {
+                const std::optional<T> previous = op.undo(task.remaining, operands[task.last]);
+
+                if (previous)
+                {
+                    pending++;
+                    own.push(SearchTask{task.row, *previous, task.last - 1});
+                }
+            };
+
+            (split(ops), ...);
+        }
+    };
+
+    const auto worker = [&](const std::size_t id) {
+        while (pending > 0)
+        {
+            std::optional<SearchTask> task = queues[id].pop();
+
+            for (std::size_t i = 1; !task && i < num_threads; i++)
+                task = queues[(id + i) % num_threads].steal();
+
+            if (!task)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            run(queues[id], *task);
+            pending--;
+        }
+    };
+
+    std::vector<std::thread> workers;
+
+    for (std::size_t i = 1; i < num_threads; i++)
+        workers.emplace_back(worker, i);
+
+    worker(0);
+
+    for (auto& thread : workers)
+        thread.join();
+
+    T ans = 0;
+
+    for (std::size_t i = 0; i < size(data.data); i++)
+        if (found[i])
+            ans += data.data[i].first;
+
+    return ans;
+}
+
+template<typename... Ops>
+Data::value_type sum_possible_reachable(const Data& data, Ops... ops) {
+    using T = Data::value_type;
+
+    T                 ans = 0;
+    ReachableSetCache cache{data};
+
+    // Dropping values above a bound is only sound while no operator can bring them back down, so
+    // rows that multiply by zero take the same fallback as in the backwards search.
+    for (const auto& [target, operands] : data.data)
+    {
+        const auto is_zero  = [](const auto operand) { return static_cast<T>(operand) == 0; };
+        const bool has_zero = !operands.empty()
+                           && std::any_of(std::next(cbegin(operands)), cend(operands), is_zero);
+
+        if (has_zero ? is_possible_backwards(target, cbegin(operands), cend(operands), ops...)
+                     : cache.is_reachable(target, operands, ops...))
+            ans += target;
+    }
+
+    return ans;
+}
+
+// Evaluates every operator combination breadth-first, one level per operand, four lanes at a
+// time. Level `i` holds `sizeof...(Ops)^i` values, the block for each operator stored contiguously;
+// values above the target are clamped to `target + 1`, which no operator can bring back down.
+// Returns nothing when the row is too long, contains a zero operand, or could overflow, and for
+// any `T` other than the 64-bit lane type.
+template<typename T, typename... Ops>
+CPU_DISPATCH std::optional<bool>
+is_possible_vectorized(const T target, const std::vector<Extended<T>>& operands, Ops... ops) {
+    using std::size;
+
+    if constexpr (!std::is_same_v<T, std::uint64_t>)
+        return std::nullopt;
+
+    else
+    {
+        constexpr std::size_t LANES = sizeof(u64x4) / sizeof(T);
+
+        if (operands.empty())
+            return false;
+
+        if (target == std::numeric_limits<T>::max())
+            return std::nullopt;
+
+        const T     sentinel     = target + 1;
+        std::size_t combinations = 1;
+
+        for (std::size_t i = 1; i < size(operands); i++)
+        {
+            combinations *= sizeof...(ops);
+
+            if (combinations > VECTORIZED_MAX_COMBINATIONS || static_cast<T>(operands[i]) == 0)
+                return std::nullopt;
+
+            const auto fits = [&](const auto op) {
+                T scaled, shifted;
+                return !__builtin_mul_overflow(sentinel, op.factor(operands[i]), &scaled)
+                    && !__builtin_add_overflow(scaled, static_cast<T>(operands[i]), &shifted);
+            };
+
+            if (!(fits(ops) && ...))
+                return std::nullopt;
+        }
+
+        // One spare vector absorbs the tail of the last block, which spills past its end.
+        thread_local std::vector<T> current;
+        thread_local std::vector<T> next;
+
+        current.assign(combinations + LANES, sentinel);
+        next.assign(combinations + LANES, sentinel);
+        current[0] = std::min(static_cast<T>(operands[0]), sentinel);
+
+        std::size_t count = 1;
+
+        for (std::size_t i = 1; i < size(operands); i++)
+        {
+            std::size_t block = 0;
+
+            const auto expand = [&](const auto op) {
+                for (std::size_t lane = 0; lane < count; lane += LANES)
+                {
+                    u64x4 values;
+                    std::memcpy(&values, &current[lane], sizeof(values));
+
+                    op.apply_to_lanes(values, operands[i]);
+                    values = values > sentinel ? sentinel : values;
+
+                    std::memcpy(&next[block * count + lane], &values, sizeof(values));
+                }
+
+                block++;
+            };
+
+            (expand(ops), ...);
+
+            count *= sizeof...(ops);
+            std::swap(current, next);
+        }
+
+        u64x4 matches{};
+
+        for (std::size_t lane = 0; lane < count; lane += LANES)
+        {
+            u64x4 values;
+            std::memcpy(&values, &current[lane], sizeof(values));
+            matches |= values == target;
+        }
+
+        for (std::size_t lane = 0; lane < LANES; lane++)
+            if (matches[lane])
+                return true;
+
+        return false;
+    }
+}
+
+template<typename... Ops>
+Data::value_type sum_possible_vectorized(const Data& data, Ops... ops) {
+    using std::cbegin;
+    using std::cend;
+
+    Data::value_type ans = 0;
+
+    for (const auto& [target, operands] : data.data)
+    {
+        const std::optional<bool> possible = is_possible_vectorized(target, operands, ops...);
+
+        if (possible ? *possible
+                     : is_possible_backwards(target, cbegin(operands), cend(operands), ops...))
+            ans += target;
+    }
+
+    return ans;
+}
+
+int main(int argc, char* argv[]) {
+    solve(parse_from(std::fstream{argc > 1 ? argv[1] : "data.txt"}));
+}
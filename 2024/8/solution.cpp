@@ -1,166 +1,207 @@
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
 #include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
 #include <unordered_map>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "../common/arena.hpp"
+#include "../common/grid.hpp"
+#include "../common/instrument.hpp"
+
 struct Data;
-struct Position;
-struct Direction;
-struct PositionHasher;
-struct IAntinodeGenerator;
+struct Line;
+struct EquidistantAntinodeGenerator;
+struct ColinearAntinodeGenerator;
+
+// One bit per cell of the map.
+using AntinodeMap = GridBitmap<>;
+using Antennas    = std::pmr::vector<Position>;
 
 Data parse_from(std::fstream&&);
 void solve(Data&&);
 void solve_q1(const Data&);
 void solve_q2(const Data&);
 
-constexpr Position  operator+(const Position, const Direction) noexcept;
-constexpr Position& operator+=(Position&, const Direction) noexcept;
-constexpr bool      operator==(const Position, const Position) noexcept;
-
-constexpr Direction operator-(const Position, const Position) noexcept;
-
-constexpr bool in_bounds(const Position, std::size_t, std::size_t) noexcept;
-
-void insert_antinodes(std::unordered_set<Position, PositionHasher>&,
-                      const std::vector<Position>&,
-                      const IAntinodeGenerator&);
+constexpr int floor_div(const int, const int) noexcept;
+constexpr int ceil_div(const int, const int) noexcept;
 
-struct Direction {
-    int x;
-    int y;
-};
+template<typename AntinodeGenerator>
+void insert_antinodes(AntinodeMap&,
+                      const Antennas&,
+                      std::size_t,
+                      std::size_t,
+                      const AntinodeGenerator&);
 
-struct Position {
-    int x;
-    int y;
-};
+template<typename AntinodeGenerator>
+AntinodeMap collect_antinodes(const Data&, const AntinodeGenerator&);
 
-struct PositionHasher {
-    constexpr PositionHasher(size_t w) :
-        width(w) {}
+template<typename Body>
+void parallel_for(const std::size_t, const std::size_t, const Body&);
 
-    constexpr size_t operator()(const Position& pos) const { return pos.x * width + pos.y; }
+std::size_t worker_count(const std::size_t);
 
-   private:
-    size_t width;
+// The in-bounds part of a grid line: `length` points starting at `anchor`, `step` apart. Lines
+// built by `ColinearAntinodeGenerator::line_through` are normalised (`step` reduced by its gcd and
+// pointing down or right, `anchor` the first in-bounds point), so equal lines compare equal.
+struct Line {
+    Position  anchor;
+    Direction step;
+    int       length;
 };
 
-constexpr bool operator==(const Position lhs, const Position rhs) noexcept {
-    return lhs.x == rhs.x && lhs.y == rhs.y;
-}
-
-constexpr Position operator+(const Position pos, const Direction direction) noexcept {
-    return Position{pos.x + direction.x, pos.y + direction.y};
+constexpr bool operator==(const Line lhs, const Line rhs) noexcept {
+    return lhs.anchor == rhs.anchor && lhs.step == rhs.step;
 }
 
-constexpr Position& operator+=(Position& pos, const Direction direction) noexcept {
-    pos.x += direction.x;
-    pos.y += direction.y;
-    return pos;
+constexpr bool operator<(const Line lhs, const Line rhs) noexcept {
+    return std::tie(lhs.anchor.x, lhs.anchor.y, lhs.step.x, lhs.step.y)
+         < std::tie(rhs.anchor.x, rhs.anchor.y, rhs.step.x, rhs.step.y);
 }
 
-constexpr Position& operator-=(Position& pos, const Direction direction) noexcept {
-    pos.x -= direction.x;
-    pos.y -= direction.y;
-    return pos;
-}
-
-constexpr Direction operator-(const Position left, const Position right) noexcept {
-    return Direction{left.x - right.x, left.y - right.y};
-}
+// Arena bytes per input byte: most cells are empty, and each antenna appends one position to the
+// list of its frequency.
+constexpr std::size_t ARENA_BYTES_PER_INPUT_BYTE = 4;
 
+// The antenna lists live in `arena`.
 struct Data {
-    std::unordered_map<char, std::vector<Position>> antennas;
-    std::size_t                                     width;
-    std::size_t                                     height;
+    std::unique_ptr<Arena>                  arena;
+    std::pmr::unordered_map<char, Antennas> antennas;
+    std::size_t                             width;
+    std::size_t                             height;
+
+    Data() = default;
+    explicit Data(std::unique_ptr<Arena> resource) :
+        arena(std::move(resource)),
+        antennas(arena.get()) {}
 
-    Data()                       = default;
     Data(const Data&)            = delete;
     Data& operator=(const Data&) = delete;
     Data(Data&&)                 = default;
-    Data& operator=(Data&&)      = default;
+    Data& operator=(Data&&)      = delete;
 };
 
-struct IAntinodeGenerator {
-    virtual void insert_antinodes(std::unordered_set<Position, PositionHasher>&,
-                                  const Position,
-                                  const Position) const = 0;
-    virtual ~IAntinodeGenerator()                       = default;
-};
+// Antinode generators are passed to `insert_antinodes` as a template parameter so the pair loop
+// inlines the generator. Any type providing
+//     void insert_antinodes(AntinodeMap&, const Position, const Position) const;
+// can be used as a generator. Generators whose antinodes are whole lines may also provide
+//     Line line_through(const Position, const Position) const;
+//     void rasterize(AntinodeMap&, const Line) const;
+// in which case `collect_antinodes` deduplicates the lines of each frequency before drawing them.
 
-struct EquidistantAntinodeGenerator: IAntinodeGenerator {
+struct EquidistantAntinodeGenerator {
     EquidistantAntinodeGenerator(std::size_t w, std::size_t h) :
         width(w),
         height(h) {}
-    virtual void insert_antinodes(std::unordered_set<Position, PositionHasher>&,
-                                  const Position,
-                                  const Position) const final;
-    virtual ~EquidistantAntinodeGenerator() = default;
+    void insert_antinodes(AntinodeMap&, const Position, const Position) const;
 
    private:
     std::size_t width;
     std::size_t height;
 };
 
-struct ColinearAntinodeGenerator: IAntinodeGenerator {
+template<typename AntinodeGenerator, typename = void>
+struct is_line_generator: std::false_type {};
+
+template<typename AntinodeGenerator>
+struct is_line_generator<AntinodeGenerator,
+                         std::void_t<decltype(std::declval<const AntinodeGenerator&>().line_through(
+                           Position{}, Position{}))>>: std::true_type {};
+
+struct ColinearAntinodeGenerator {
     ColinearAntinodeGenerator(std::size_t w, std::size_t h) :
         width(w),
         height(h) {}
-    virtual void insert_antinodes(std::unordered_set<Position, PositionHasher>&,
-                                  const Position,
-                                  const Position) const final;
-    virtual ~ColinearAntinodeGenerator() = default;
+    void insert_antinodes(AntinodeMap&, const Position, const Position) const;
+    Line line_through(const Position, const Position) const;
+    void rasterize(AntinodeMap&, const Line) const;
 
    private:
     std::size_t width;
     std::size_t height;
 };
 
-constexpr bool in_bounds(const Position pos, std::size_t height, std::size_t width) noexcept {
-    return pos.x >= 0 && pos.y >= 0 && pos.x < height && pos.y < width;
+constexpr int floor_div(const int a, const int b) noexcept {
+    return a / b - ((a % b != 0) && ((a < 0) != (b < 0)));
 }
 
-void EquidistantAntinodeGenerator::insert_antinodes(
-  std::unordered_set<Position, PositionHasher>& container,
-  const Position                                a,
-  const Position                                b) const {
+constexpr int ceil_div(const int a, const int b) noexcept {
+    return a / b + ((a % b != 0) && ((a < 0) == (b < 0)));
+}
+
+void EquidistantAntinodeGenerator::insert_antinodes(AntinodeMap&   container,
+                                                    const Position a,
+                                                    const Position b) const {
     Position tmp = a + (a - b);
     if (in_bounds(tmp, height, width))
         container.insert(tmp);
     tmp = b + (b - a);
     if (in_bounds(tmp, height, width))
-        container.insert(b + (b - a));
+        container.insert(tmp);
 }
 
-void ColinearAntinodeGenerator::insert_antinodes(
-  std::unordered_set<Position, PositionHasher>& container,
-  const Position                                a,
-  const Position                                b) const {
-    Direction dir = a - b;
-    Position  tmp = a;
-    while (in_bounds(tmp, height, width))
-    {
-        container.insert(tmp);
-        tmp += dir;
-    }
-    tmp = b;
-    while (in_bounds(tmp, height, width))
-    {
-        container.insert(tmp);
-        tmp -= dir;
-    }
+void ColinearAntinodeGenerator::insert_antinodes(AntinodeMap&   container,
+                                                 const Position a,
+                                                 const Position b) const {
+    rasterize(container, line_through(a, b));
+}
+
+Line ColinearAntinodeGenerator::line_through(const Position a, const Position b) const {
+    Direction step    = a - b;
+    const int divisor = std::gcd(step.x, step.y);
+    const int limit_x = static_cast<int>(height) - 1;
+    const int limit_y = static_cast<int>(width) - 1;
+    int       first   = std::numeric_limits<int>::min();
+    int       last    = std::numeric_limits<int>::max();
+
+    step = Direction{step.x / divisor, step.y / divisor};
+
+    if (step.x < 0 || (step.x == 0 && step.y < 0))
+        step = Direction{-step.x, -step.y};
+
+    // Range of `t` for which `a + t * step` stays inside the map, solved per axis.
+    const auto clip = [&](const int coord, const int delta, const int limit) {
+        if (delta == 0)
+            return;
+
+        const int low  = delta > 0 ? ceil_div(-coord, delta) : ceil_div(limit - coord, delta);
+        const int high = delta > 0 ? floor_div(limit - coord, delta) : floor_div(-coord, delta);
+
+        first = std::max(first, low);
+        last  = std::min(last, high);
+    };
+
+    clip(a.x, step.x, limit_x);
+    clip(a.y, step.y, limit_y);
+
+    return Line{a + step * first, step, last - first + 1};
+}
+
+void ColinearAntinodeGenerator::rasterize(AntinodeMap& container, const Line line) const {
+    Position pos = line.anchor;
+
+    for (int i = 0; i < line.length; i++, pos += line.step)
+        container.insert(pos);
 }
 
 Data parse_from(std::fstream&& file) {
+    INSTRUMENT_PHASE("parse_from");
+
     using std::size;
 
-    Data        result;
+    Data        result{make_arena(file, ARENA_BYTES_PER_INPUT_BYTE)};
     std::string line;
     int         line_count = 0;
 
@@ -189,40 +230,146 @@ void solve(Data&& data) {
 }
 
 void solve_q1(const Data& data) {
+    INSTRUMENT_PHASE("solve_q1");
+
     using std::cbegin;
     using std::cend;
     using std::size;
 
-    std::unordered_set<Position, PositionHasher> antinodes{0, PositionHasher{data.width}};
-
-    for (const auto& frequency : data.antennas)
-        insert_antinodes(antinodes, frequency.second,
-                         EquidistantAntinodeGenerator{data.width, data.height});
-
-    std::cout << size(antinodes) << std::endl;
+    std::cout << size(
+      collect_antinodes(data, EquidistantAntinodeGenerator{data.width, data.height}))
+              << std::endl;
 }
 
 void solve_q2(const Data& data) {
+    INSTRUMENT_PHASE("solve_q2");
+
     using std::cbegin;
     using std::cend;
     using std::size;
 
-    std::unordered_set<Position, PositionHasher> antinodes{0, PositionHasher{data.width}};
+    std::cout << size(collect_antinodes(data, ColinearAntinodeGenerator{data.width, data.height}))
+              << std::endl;
+}
+
+// Inserts the antinodes of every pair whose first antenna has an index in [first, last).
+template<typename AntinodeGenerator>
+void insert_antinodes(AntinodeMap&             to_insert,
+                      const Antennas&          antennas,
+                      const std::size_t        first,
+                      const std::size_t        last,
+                      const AntinodeGenerator& gen) {
+
+    for (std::size_t i = first; i < last; i++)
+        for (std::size_t j = i + 1; j < size(antennas); j++)
+            gen.insert_antinodes(to_insert, antennas[i], antennas[j]);
+}
+
+// Frequencies are independent, and large frequencies are further split by the first antenna of
+// each pair. Workers mark antinodes in a private map, and the maps are OR-ed together at the end.
+// Line generators first collect the distinct lines of each task, then merge and draw the lines of
+// each frequency, so a line through many antennas is drawn once.
+template<typename AntinodeGenerator>
+AntinodeMap collect_antinodes(const Data& data, const AntinodeGenerator& gen) {
+    using std::begin;
+    using std::end;
+    using std::size;
+
+    struct Task {
+        const Antennas* antennas;
+        std::size_t     first;
+        std::size_t     last;
+    };
+
+    constexpr std::size_t ANTENNAS_PER_TASK = 16;
+
+    std::vector<Task>        tasks;
+    std::vector<std::size_t> frequency_tasks{0};
 
     for (const auto& frequency : data.antennas)
-        insert_antinodes(antinodes, frequency.second,
-                         ColinearAntinodeGenerator{data.width, data.height});
+    {
+        for (std::size_t first = 0; first < size(frequency.second); first += ANTENNAS_PER_TASK)
+            tasks.push_back(Task{&frequency.second, first,
+                                 std::min(first + ANTENNAS_PER_TASK, size(frequency.second))});
+
+        frequency_tasks.push_back(size(tasks));
+    }
+
+    const std::size_t        num_threads = worker_count(size(tasks));
+    std::vector<AntinodeMap> antinodes(num_threads, AntinodeMap{data.height, data.width});
+
+    if constexpr (is_line_generator<AntinodeGenerator>::value)
+    {
+        std::vector<std::vector<Line>> task_lines(size(tasks));
 
-    std::cout << size(antinodes) << std::endl;
+        parallel_for(size(tasks), num_threads, [&](std::size_t, const std::size_t i) {
+            const auto& antennas = *tasks[i].antennas;
+            auto&       lines    = task_lines[i];
+
+            for (std::size_t a = tasks[i].first; a < tasks[i].last; a++)
+                for (std::size_t b = a + 1; b < size(antennas); b++)
+                    lines.push_back(gen.line_through(antennas[a], antennas[b]));
+
+            std::sort(begin(lines), end(lines));
+            lines.erase(std::unique(begin(lines), end(lines)), end(lines));
+        });
+
+        const auto draw_frequency = [&](const std::size_t worker, const std::size_t frequency) {
+            std::vector<Line> lines;
+
+            for (std::size_t i = frequency_tasks[frequency]; i < frequency_tasks[frequency + 1];
+                 i++)
+                lines.insert(end(lines), begin(task_lines[i]), end(task_lines[i]));
+
+            std::sort(begin(lines), end(lines));
+            lines.erase(std::unique(begin(lines), end(lines)), end(lines));
+
+            for (const Line line : lines)
+                gen.rasterize(antinodes[worker], line);
+        };
+
+        parallel_for(size(frequency_tasks) - 1, num_threads, draw_frequency);
+    }
+
+    else
+        parallel_for(size(tasks), num_threads, [&](const std::size_t worker, const std::size_t i) {
+            insert_antinodes(antinodes[worker], *tasks[i].antennas, tasks[i].first, tasks[i].last,
+                             gen);
+        });
+
+    for (std::size_t i = 1; i < num_threads; i++)
+        antinodes[0] |= antinodes[i];
+
+    return std::move(antinodes[0]);
 }
 
-void insert_antinodes(std::unordered_set<Position, PositionHasher>& to_insert,
-                      const std::vector<Position>&                  antennas,
-                      const IAntinodeGenerator&                     gen) {
+std::size_t worker_count(const std::size_t num_tasks) {
+    return std::max<std::size_t>(
+      1, std::min<std::size_t>(std::thread::hardware_concurrency(), num_tasks));
+}
 
-    for (int i = 0; i < size(antennas); i++)
-        for (int j = i + 1; j < size(antennas); j++)
-            gen.insert_antinodes(to_insert, antennas[i], antennas[j]);
+// Runs `body(worker, task)` for every task in [0, num_tasks) on `num_threads` threads, which claim
+// tasks from a shared counter. `worker` identifies the calling thread in [0, num_threads).
+template<typename Body>
+void parallel_for(const std::size_t num_tasks, const std::size_t num_threads, const Body& body) {
+    std::atomic<std::size_t> next_task{0};
+
+    const auto worker = [&](const std::size_t id) {
+        for (std::size_t i = next_task++; i < num_tasks; i = next_task++)
+            body(id, i);
+    };
+
+    std::vector<std::thread> workers;
+
+    for (std::size_t i = 1; i < num_threads; i++)
+        workers.emplace_back(worker, i);
+
+    worker(0);
+
+    for (auto& thread : workers)
+        thread.join();
 }
 
-int main() { solve(parse_from(std::fstream{"data.txt"})); }
+int main(int argc, char* argv[]) {
+    solve(parse_from(std::fstream{argc > 1 ? argv[1] : "data.txt"}));
+}
@@ -8,25 +8,120 @@
 #include <iostream>
 #include <iterator>
 #include <limits>
+#include <optional>
+#include <queue>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../common/instrument.hpp"
+
 struct Data;
+class MappedFile;
+
+Data                parse_from(std::fstream&&);
+std::optional<Data> map_from(const char*);
+void                solve(Data&&);
+void                solve_q1(const Data&);
+void                solve_q2(const Data&);
+std::uint64_t       condensed_checksum(std::string_view);
+std::uint64_t       unfragmented_checksum(std::string_view);
+
+constexpr std::uint64_t run_checksum(std::uint64_t, std::uint64_t, std::uint64_t) noexcept;
+
+// Read-only private mapping of a whole file. The compaction algorithms consume the disk map from
+// both ends, so mapping it lets the kernel page in just the two regions being read instead of
+// copying the whole map onto the heap.
+class MappedFile {
+   public:
+    MappedFile() = default;
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept :
+        address(std::exchange(other.address, nullptr)),
+        length(std::exchange(other.length, 0)) {}
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        std::swap(address, other.address);
+        std::swap(length, other.length);
+        return *this;
+    }
+
+    ~MappedFile() {
+        if (address)
+            munmap(address, length);
+    }
+
+    // Fails for anything that cannot be mapped, such as an empty file or a pipe.
+    static std::optional<MappedFile> open(const char* path) {
+        const int fd = ::open(path, O_RDONLY);
+
+        if (fd < 0)
+            return std::nullopt;
+
+        struct stat info;
+        MappedFile  result;
+
+        if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0)
+        {
+            void* address = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if (address != MAP_FAILED)
+            {
+                result.address = address;
+                result.length  = info.st_size;
+            }
+        }
 
-Data             parse_from(std::fstream&&);
-void             solve(Data&&);
-void             solve_q1(const Data&);
-void             solve_q2(const Data&);
-std::vector<int> condense(const std::string&);
-std::vector<int> unfragmented_condense(const std::string&);
-std::uint64_t    checksum(const std::vector<int>&);
+        close(fd);
+
+        if (!result.address)
+            return std::nullopt;
+
+        return result;
+    }
+
+    std::string_view view() const noexcept {
+        return std::string_view{static_cast<const char*>(address), length};
+    }
+
+    explicit operator bool() const noexcept { return address != nullptr; }
+
+   private:
+    void*       address = nullptr;
+    std::size_t length  = 0;
+};
 
+// The disk map either lives on the heap, read by `parse_from`, or in a mapping made by `map_from`.
 struct Data {
-    std::string data;
+    std::string storage;
+    MappedFile  mapping;
+
+    std::string_view disk_map() const noexcept {
+        if (!mapping)
+            return storage;
+
+        std::string_view result = mapping.view();
+
+        while (!result.empty() && std::isspace(static_cast<unsigned char>(result.back())))
+            result.remove_suffix(1);
+
+        while (!result.empty() && std::isspace(static_cast<unsigned char>(result.front())))
+            result.remove_prefix(1);
+
+        return result;
+    }
 
     Data()                       = default;
     Data(const Data&)            = delete;
@@ -36,12 +131,27 @@ struct Data {
 };
 
 Data parse_from(std::fstream&& file) {
+    INSTRUMENT_PHASE("parse_from");
+
     using std::size;
 
     Data result;
 
-    file >> result.data;
+    file >> result.storage;
+
+    return result;
+}
+
+std::optional<Data> map_from(const char* path) {
+    INSTRUMENT_PHASE("map_from");
 
+    std::optional<MappedFile> mapping = MappedFile::open(path);
+
+    if (!mapping)
+        return std::nullopt;
+
+    Data result;
+    result.mapping = std::move(*mapping);
     return result;
 }
 
@@ -51,154 +161,153 @@ void solve(Data&& data) {
 }
 
 void solve_q1(const Data& data) {
+    INSTRUMENT_PHASE("solve_q1");
+
     using std::cbegin;
     using std::cend;
     using std::size;
 
-    std::cout << checksum(condense(data.data)) << std::endl;
+    std::cout << condensed_checksum(data.disk_map()) << std::endl;
 }
 
 void solve_q2(const Data& data) {
+    INSTRUMENT_PHASE("solve_q2");
+
     using std::cbegin;
     using std::cend;
     using std::size;
 
-    std::cout << checksum(unfragmented_condense(data.data)) << std::endl;
+    std::cout << unfragmented_checksum(data.disk_map()) << std::endl;
 }
 
-std::vector<int> condense(const std::string& disk_map) {
+// Compacts block by block without materialising anything: the compacted disk is contiguous from
+// block 0, so one pointer walks the disk map from the front, emitting files in place and filling
+// each free span with whole chunks taken from the file the other pointer holds at the back.
+std::uint64_t condensed_checksum(const std::string_view disk_map) {
     using std::size;
 
-    bool             free_space    = false;
-    int              curr_file_num = 0;
-    std::vector<int> disk;
+    if (disk_map.empty())
+        return 0;
+
+    const auto digit = [&](const std::size_t i) {
+        return static_cast<std::uint64_t>(disk_map[i] - '0');
+    };
 
-    for (const auto ch : disk_map)
+    std::size_t   front     = 0;
+    std::size_t   back      = (size(disk_map) - 1) / 2 * 2;
+    std::uint64_t back_left = digit(back);
+    std::uint64_t position  = 0;
+    std::uint64_t sum       = 0;
+
+    while (front < back)
     {
-        int len = ch - '0';
-        if (free_space)
-            for (int i = 0; i < len; i++)
-                disk.push_back(-1);
-        else
+        if (front % 2 == 0)
         {
-            for (int i = 0; i < len; i++)
-                disk.push_back(curr_file_num);
-
-            curr_file_num++;
+            sum += run_checksum(front / 2, position, digit(front));
+            position += digit(front);
         }
 
-        free_space = !free_space;
-    }
-
-    std::size_t next_free = 0;
-    std::size_t next_data = size(disk) - 1;
+        else
+            for (std::uint64_t gap = digit(front); gap > 0 && front < back;)
+            {
+                const std::uint64_t moved = std::min(gap, back_left);
+
+                sum += run_checksum(back / 2, position, moved);
+                position += moved;
+                gap -= moved;
+                back_left -= moved;
+
+                if (back_left == 0)
+                {
+                    back -= 2;
+                    back_left = digit(back);
+                }
+            }
 
-    while (next_free < size(disk) && disk[next_free] != -1)
-    {
-        next_free++;
+        front++;
     }
 
-    while (next_free < next_data && disk[next_data] == -1)
-    {
-        disk.pop_back();
-        next_data--;
-    }
-
-    while (next_free < next_data)
-    {
-        std::swap(disk[next_free], disk[next_data]);
-
-        while (next_free < size(disk) && disk[next_free] != -1)
-            next_free++;
-
-        while (next_free < next_data && disk[next_data] == -1)
-        {
-            disk.pop_back();
-            next_data--;
-        }
-    }
+    if (front == back)
+        sum += run_checksum(back / 2, position, back_left);
 
-    return disk;
+    return sum;
 }
 
-std::vector<int> unfragmented_condense(const std::string& disk_map) {
+// Moves whole files, last to first, into the leftmost free span that fits. A file is visited once
+// and nothing ever moves into the space a file leaves, so its checksum can be taken on the spot;
+// only the free spans are stored, 8 bytes each, while the files are read back from the disk map.
+std::uint64_t unfragmented_checksum(const std::string_view disk_map) {
     using std::size;
 
-    bool                             free_space    = false;
-    int                              curr_file_num = 0;
-    std::vector<std::pair<int, int>> labeled_disk_map;
+    // Spans are at most 9 blocks long, so free spans are bucketed by exact length, each bucket a
+    // min-heap of start positions. The leftmost span that fits a file is the smallest top among
+    // the buckets at least as long as the file.
+    using MinHeap =
+      std::priority_queue<std::uint64_t, std::vector<std::uint64_t>, std::greater<std::uint64_t>>;
 
-    for (const auto ch : disk_map)
+    const auto digit = [&](const std::size_t i) {
+        return static_cast<std::uint64_t>(disk_map[i] - '0');
+    };
+
+    std::array<MinHeap, 10> free_spans;
+    std::uint64_t           end = 0;
+
+    for (std::size_t i = 0; i < size(disk_map); i++)
     {
-        int len = ch - '0';
-        if (free_space)
-            labeled_disk_map.push_back(std::make_pair(-1, len));
-        else
-        {
-            labeled_disk_map.push_back(std::make_pair(curr_file_num, len));
-            curr_file_num++;
-        }
+        if (i % 2 == 1 && digit(i) > 0)
+            free_spans[digit(i)].push(end);
 
-        free_space = !free_space;
+        end += digit(i);
     }
 
-    for (int i = curr_file_num - 1; i >= 0; i--)
+    std::uint64_t sum = 0;
+
+    for (std::size_t i = size(disk_map); i-- > 0;)
     {
-        int curr_index;
+        const std::uint64_t length = digit(i);
+        const std::uint64_t start  = end - length;
 
-        for (int j = size(labeled_disk_map) - 1; j >= 0; j--)
-        {
-            if (labeled_disk_map[j].first == i)
-            {
-                curr_index = j;
-                break;
-            }
-        }
+        end = start;
 
-        for (int j = 0; j < curr_index; j++)
-        {
-            if (labeled_disk_map[j].first == -1
-                && labeled_disk_map[j].second >= labeled_disk_map[curr_index].second)
-            {
-                const auto curr_file = labeled_disk_map[curr_index];
-                const auto remaining_space =
-                  std::make_pair(-1, labeled_disk_map[j].second - curr_file.second);
-                labeled_disk_map[curr_index].first = -1;
-                labeled_disk_map.erase(std::next(labeled_disk_map.begin(), j));
-                labeled_disk_map.insert(std::next(labeled_disk_map.begin(), j),
-                                        {curr_file, remaining_space});
-                break;
-            }
-        }
-    }
+        // Empty files add nothing to the checksum and must not take a span.
+        if (i % 2 == 1 || length == 0)
+            continue;
 
-    std::vector<int> disk;
+        std::size_t best_len = 0;
 
-    for (const auto [label, size] : labeled_disk_map)
-    {
-        if (label == -1)
-            for (int i = 0; i < size; i++)
-                disk.push_back(-1);
-        else
-            for (int i = 0; i < size; i++)
-                disk.push_back(label);
-    }
+        for (std::size_t span_len = length; span_len < size(free_spans); span_len++)
+            if (!free_spans[span_len].empty() && free_spans[span_len].top() < start
+                && (best_len == 0 || free_spans[span_len].top() < free_spans[best_len].top()))
+                best_len = span_len;
 
-    return disk;
-}
+        if (best_len == 0)
+        {
+            sum += run_checksum(i / 2, start, length);
+            continue;
+        }
 
-std::uint64_t checksum(const std::vector<int>& disk) {
-    using std::size;
+        const std::uint64_t target = free_spans[best_len].top();
+        free_spans[best_len].pop();
 
-    std::uint64_t sum = 0;
+        if (best_len > length)
+            free_spans[best_len - length].push(target + length);
 
-    for (int i = 0; i < size(disk); i++)
-    {
-        if (disk[i] != -1)
-            sum += i * disk[i];
+        sum += run_checksum(i / 2, target, length);
     }
 
     return sum;
 }
 
-int main() { solve(parse_from(std::fstream{"data.txt"})); }
+// `id * (start + (start + 1) + ... + (start + length - 1))`.
+constexpr std::uint64_t run_checksum(const std::uint64_t id,
+                                     const std::uint64_t start,
+                                     const std::uint64_t length) noexcept {
+    return id * (length * start + length * (length - 1) / 2);
+}
+
+int main(int argc, char* argv[]) {
+    const char* path = argc > 1 ? argv[1] : "data.txt";
+
+    std::optional<Data> mapped = map_from(path);
+    solve(mapped ? std::move(*mapped) : parse_from(std::fstream{path}));
+}
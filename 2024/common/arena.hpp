@@ -0,0 +1,46 @@
+#pragma once
+
+// Monotonic arenas for the containers built while parsing a puzzle input.
+//
+// A `Data` struct owns its arena through a `std::unique_ptr`, so the resource keeps its address
+// when the struct is moved, and declares it before the `std::pmr` containers that allocate from
+// it, so the containers are destroyed first. Deallocation is a no-op and the arena releases
+// everything at once when it is destroyed.
+//
+// Such structs delete move assignment: polymorphic allocators do not propagate on assignment, so
+// the assigned-to containers would keep pointing into the arena being replaced.
+
+#include <algorithm>
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <memory_resource>
+
+using Arena = std::pmr::monotonic_buffer_resource;
+
+// Bytes from the current position of `file` to its end, or 0 if the stream cannot seek.
+inline std::size_t remaining_size(std::istream& file) {
+    const auto start = file.tellg();
+
+    if (start < 0 || !file.seekg(0, std::ios::end))
+    {
+        file.clear();
+        return 0;
+    }
+
+    const auto end = file.tellg();
+    file.seekg(start);
+
+    return end - start;
+}
+
+// An arena whose first block holds `bytes_per_input_byte` bytes for every byte left in `file`.
+// With a factor that fits the day's input, parsing makes a single upstream allocation; if the
+// estimate is short the arena grows geometrically from the default resource.
+inline std::unique_ptr<Arena> make_arena(std::istream&     file,
+                                         const std::size_t bytes_per_input_byte) {
+    constexpr std::size_t MIN_BLOCK_SIZE = 4096;
+
+    return std::make_unique<Arena>(
+      std::max(MIN_BLOCK_SIZE, remaining_size(file) * bytes_per_input_byte));
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+// Runtime CPU dispatch for hot kernels.
+//
+// CPU_DISPATCH on a function definition compiles it once per x86-64 microarchitecture level:
+// baseline (SSE2), x86-64-v3 (AVX2, BMI2, FMA, POPCNT) and x86-64-v4 (AVX-512). The dynamic
+// loader calls an ifunc resolver that checks CPUID once at startup and binds every call to the
+// best clone the host supports, so one binary runs on any x86-64 machine.
+//
+// A dispatched function is reached through an indirect call and cannot be inlined into its
+// callers, while everything inlined into it is compiled once per level. Mark coarse kernels that
+// loop over a whole input, not helpers called inside such loops.
+//
+// Dispatch is off, and CPU_DISPATCH expands to nothing, outside GCC on x86-64 ELF targets, under
+// ThreadSanitizer, whose runtime is not yet set up when the ifunc resolvers run, and when
+// AOC_NO_DISPATCH is defined, e.g. for builds that already pass -march.
+
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__ELF__) \
+  && !defined(__SANITIZE_THREAD__) && !defined(AOC_NO_DISPATCH)
+    #define CPU_DISPATCH \
+        __attribute__((target_clones("default", "arch=x86-64-v3", "arch=x86-64-v4")))
+#else
+    #define CPU_DISPATCH
+#endif
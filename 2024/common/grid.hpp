@@ -0,0 +1,337 @@
+#pragma once
+
+// Two-dimensional grid primitives shared by the grid puzzles.
+//
+// Positions are (row, column) pairs: `x` grows downwards and `y` grows to the right, so N points
+// to the previous row and E to the next column. Storage is always a single flat buffer, addressed
+// through a layout that maps a position inside the storage rectangle to an offset.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "dispatch.hpp"
+
+struct Direction;
+struct Position;
+struct PositionHasher;
+struct RowMajorLayout;
+struct MortonLayout;
+
+template<std::size_t TileSize>
+struct TiledLayout;
+
+template<typename T, typename Layout = RowMajorLayout>
+class Grid;
+
+template<typename Layout = RowMajorLayout>
+class GridBitmap;
+
+constexpr Direction operator+(const Direction, const Direction) noexcept;
+constexpr Direction operator*(const Direction, const int) noexcept;
+constexpr bool      operator==(const Direction, const Direction) noexcept;
+constexpr bool      operator!=(const Direction, const Direction) noexcept;
+constexpr int       dot(const Direction, const Direction) noexcept;
+constexpr int       cross(const Direction, const Direction) noexcept;
+
+constexpr Position  operator+(const Position, const Direction) noexcept;
+constexpr Position  operator-(const Position, const Direction) noexcept;
+constexpr Position& operator+=(Position&, const Direction) noexcept;
+constexpr Position& operator-=(Position&, const Direction) noexcept;
+constexpr Direction operator-(const Position, const Position) noexcept;
+constexpr bool      operator==(const Position, const Position) noexcept;
+constexpr bool      operator!=(const Position, const Position) noexcept;
+
+constexpr bool          in_bounds(const Position, std::size_t, std::size_t) noexcept;
+constexpr std::size_t   flat_index(const Position, std::size_t) noexcept;
+constexpr std::uint32_t pack(const Position) noexcept;
+constexpr Position      unpack(const std::uint32_t) noexcept;
+constexpr std::uint64_t interleave_bits(const std::uint32_t, const std::uint32_t) noexcept;
+
+struct Direction {
+    int x;
+    int y;
+};
+
+constexpr Direction operator+(const Direction first, const Direction second) noexcept {
+    return Direction{first.x + second.x, first.y + second.y};
+}
+
+constexpr Direction operator*(const Direction direction, const int factor) noexcept {
+    return Direction{direction.x * factor, direction.y * factor};
+}
+
+constexpr bool operator==(const Direction lhs, const Direction rhs) noexcept {
+    return lhs.x == rhs.x && lhs.y == rhs.y;
+}
+
+constexpr bool operator!=(const Direction lhs, const Direction rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+constexpr int dot(const Direction lhs, const Direction rhs) noexcept {
+    return lhs.x * rhs.x + lhs.y * rhs.y;
+}
+
+constexpr int cross(const Direction lhs, const Direction rhs) noexcept {
+    return lhs.x * rhs.y - lhs.y * rhs.x;
+}
+
+constexpr Direction N{-1, 0};
+constexpr Direction S{1, 0};
+constexpr Direction E{0, 1};
+constexpr Direction W{0, -1};
+
+constexpr Direction NE = N + E;
+constexpr Direction NW = N + W;
+constexpr Direction SE = S + E;
+constexpr Direction SW = S + W;
+
+// Both lists run clockwise starting from N, so turning right is an index increment.
+constexpr std::array<Direction, 4> ORTHOGONAL_DIRECTIONS{N, E, S, W};
+constexpr std::array<Direction, 8> ALL_DIRECTIONS{N, NE, E, SE, S, SW, W, NW};
+
+struct Position {
+    int x;
+    int y;
+};
+
+constexpr Position operator+(const Position pos, const Direction direction) noexcept {
+    return Position{pos.x + direction.x, pos.y + direction.y};
+}
+
+constexpr Position operator-(const Position pos, const Direction direction) noexcept {
+    return Position{pos.x - direction.x, pos.y - direction.y};
+}
+
+constexpr Position& operator+=(Position& pos, const Direction direction) noexcept {
+    pos.x += direction.x;
+    pos.y += direction.y;
+    return pos;
+}
+
+constexpr Position& operator-=(Position& pos, const Direction direction) noexcept {
+    pos.x -= direction.x;
+    pos.y -= direction.y;
+    return pos;
+}
+
+constexpr Direction operator-(const Position left, const Position right) noexcept {
+    return Direction{left.x - right.x, left.y - right.y};
+}
+
+constexpr bool operator==(const Position lhs, const Position rhs) noexcept {
+    return lhs.x == rhs.x && lhs.y == rhs.y;
+}
+
+constexpr bool operator!=(const Position lhs, const Position rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+constexpr bool in_bounds(const Position pos, std::size_t height, std::size_t width) noexcept {
+    return pos.x >= 0 && pos.y >= 0 && pos.x < height && pos.y < width;
+}
+
+constexpr std::size_t flat_index(const Position pos, std::size_t width) noexcept {
+    return pos.x * width + pos.y;
+}
+
+// Packs a position into 32 bits, 16 per coordinate. Coordinates must fit in an int16_t, which
+// holds for every puzzle grid; negative coordinates survive the round trip.
+constexpr std::uint32_t pack(const Position pos) noexcept {
+    return static_cast<std::uint32_t>(static_cast<std::uint16_t>(pos.x)) << 16
+         | static_cast<std::uint16_t>(pos.y);
+}
+
+constexpr Position unpack(const std::uint32_t packed) noexcept {
+    return Position{static_cast<std::int16_t>(packed >> 16), static_cast<std::int16_t>(packed)};
+}
+
+struct PositionHasher {
+    std::size_t operator()(const Position pos) const noexcept { return pack(pos); }
+};
+
+// The positions one step away from `pos` in each of `directions`, in the same order.
+template<std::size_t Count>
+constexpr std::array<Position, Count> neighbors(const Position                        pos,
+                                                const std::array<Direction, Count>& directions) {
+    std::array<Position, Count> result{};
+
+    for (std::size_t i = 0; i < Count; i++)
+        result[i] = pos + directions[i];
+
+    return result;
+}
+
+// Spreads the low 32 bits of `x` and `y` over the odd and even bits of the result.
+constexpr std::uint64_t interleave_bits(const std::uint32_t x, const std::uint32_t y) noexcept {
+    const auto spread = [](std::uint64_t v) {
+        v = (v | v << 16) & 0x0000ffff0000ffff;
+        v = (v | v << 8) & 0x00ff00ff00ff00ff;
+        v = (v | v << 4) & 0x0f0f0f0f0f0f0f0f;
+        v = (v | v << 2) & 0x3333333333333333;
+        v = (v | v << 1) & 0x5555555555555555;
+        return v;
+    };
+
+    return spread(x) << 1 | spread(y);
+}
+
+// Layouts map a position inside a `height` x `width` rectangle to an offset into a buffer of
+// `size()` cells. Any type with that constructor, `index` and `size` can be used as a layout.
+
+struct RowMajorLayout {
+    std::size_t height = 0;
+    std::size_t width  = 0;
+
+    constexpr RowMajorLayout() = default;
+    constexpr RowMajorLayout(const std::size_t h, const std::size_t w) :
+        height(h),
+        width(w) {}
+
+    constexpr std::size_t index(const Position pos) const noexcept {
+        return flat_index(pos, width);
+    }
+
+    constexpr std::size_t size() const noexcept { return height * width; }
+};
+
+// Z-order curve: cells close in both coordinates stay close in memory, which suits access
+// patterns that move along columns and diagonals as much as along rows.
+struct MortonLayout {
+    std::size_t height = 0;
+    std::size_t width  = 0;
+
+    constexpr MortonLayout() = default;
+    constexpr MortonLayout(const std::size_t h, const std::size_t w) :
+        height(h),
+        width(w) {}
+
+    constexpr std::size_t index(const Position pos) const noexcept {
+        return interleave_bits(pos.x, pos.y);
+    }
+
+    // The curve is monotonic in each coordinate, so the bottom-right cell has the largest index.
+    constexpr std::size_t size() const noexcept {
+        return height == 0 || width == 0 ? 0 : interleave_bits(height - 1, width - 1) + 1;
+    }
+};
+
+// Square tiles of `TileSize` x `TileSize` cells, stored row-major within a tile and tile after
+// tile in row-major order.
+template<std::size_t TileSize>
+struct TiledLayout {
+    std::size_t height = 0;
+    std::size_t width  = 0;
+
+    constexpr TiledLayout() = default;
+    constexpr TiledLayout(const std::size_t h, const std::size_t w) :
+        height(h),
+        width(w) {}
+
+    constexpr std::size_t index(const Position pos) const noexcept {
+        const std::size_t tile = pos.x / TileSize * tiles_per_row() + pos.y / TileSize;
+        return tile * TileSize * TileSize + pos.x % TileSize * TileSize + pos.y % TileSize;
+    }
+
+    constexpr std::size_t size() const noexcept {
+        return (height + TileSize - 1) / TileSize * tiles_per_row() * TileSize * TileSize;
+    }
+
+   private:
+    constexpr std::size_t tiles_per_row() const noexcept {
+        return (width + TileSize - 1) / TileSize;
+    }
+};
+
+// A `height` x `width` grid surrounded by `padding` cells on every side, all in one buffer. The
+// padding holds a fill value, so code that looks up to `padding` steps past the edge needs no
+// bounds checks. Positions are logical: (0, 0) is the first cell inside the padding.
+template<typename T, typename Layout>
+class Grid {
+   public:
+    using reference       = typename std::vector<T>::reference;
+    using const_reference = typename std::vector<T>::const_reference;
+
+    Grid() = default;
+
+    Grid(const std::size_t h, const std::size_t w, const int pad = 0, const T& fill = T{}) :
+        layout(h + 2 * pad, w + 2 * pad),
+        cells(layout.size(), fill),
+        rows(h),
+        columns(w),
+        margin(pad) {}
+
+    reference operator[](const Position pos) noexcept {
+        return cells[layout.index(pos + Direction{margin, margin})];
+    }
+
+    const_reference operator[](const Position pos) const noexcept {
+        return cells[layout.index(pos + Direction{margin, margin})];
+    }
+
+    // True for positions inside the grid proper, excluding the padding.
+    constexpr bool contains(const Position pos) const noexcept {
+        return in_bounds(pos, rows, columns);
+    }
+
+    constexpr std::size_t height() const noexcept { return rows; }
+    constexpr std::size_t width() const noexcept { return columns; }
+    constexpr int         padding() const noexcept { return margin; }
+
+   private:
+    Layout         layout;
+    std::vector<T> cells;
+    std::size_t    rows    = 0;
+    std::size_t    columns = 0;
+    int            margin  = 0;
+};
+
+// A set of positions of a `height` x `width` grid, one bit per cell.
+template<typename Layout>
+class GridBitmap {
+   public:
+    GridBitmap() = default;
+
+    GridBitmap(const std::size_t h, const std::size_t w) :
+        layout(h, w),
+        words((layout.size() + 63) / 64) {}
+
+    // Returns whether `pos` was not in the set before.
+    bool insert(const Position pos) noexcept {
+        const std::size_t   index = layout.index(pos);
+        const std::uint64_t bit   = std::uint64_t{1} << (index % 64);
+        const bool          fresh = !(words[index / 64] & bit);
+
+        words[index / 64] |= bit;
+        return fresh;
+    }
+
+    bool contains(const Position pos) const noexcept {
+        const std::size_t index = layout.index(pos);
+        return words[index / 64] >> (index % 64) & 1;
+    }
+
+    CPU_DISPATCH GridBitmap& operator|=(const GridBitmap& other) noexcept {
+        for (std::size_t i = 0; i < words.size(); i++)
+            words[i] |= other.words[i];
+
+        return *this;
+    }
+
+    CPU_DISPATCH std::size_t size() const noexcept {
+        std::size_t count = 0;
+
+        for (const auto word : words)
+            count += __builtin_popcountll(word);
+
+        return count;
+    }
+
+   private:
+    Layout                     layout;
+    std::vector<std::uint64_t> words;
+};
@@ -0,0 +1,457 @@
+#pragma once
+
+// Scoped timers and event counters for the hot paths of the solutions.
+//
+//     INSTRUMENT_PHASE("solve_q2");            // times the rest of the scope, with perf counters
+//     INSTRUMENT_SCOPE("will_halt");           // times the rest of the enclosing scope
+//     INSTRUMENT_COUNT("search nodes", 1);     // adds to a named counter
+//
+// The macros expand to nothing unless AOC_INSTRUMENT is defined, so instrumented code compiles to
+// exactly the uninstrumented binary by default, and the arguments are never evaluated.
+//
+// When enabled, each thread records into its own buffer: timestamps come from the TSC where
+// available and are converted to microseconds against std::chrono::steady_clock at exit. At exit
+// a summary (call count and total time per scope, total per counter) is written as JSON to
+// stderr, or, if AOC_TRACE names a file, a Chrome trace (chrome://tracing, Perfetto) holding
+// every scope and the final counter values is written there with the summary alongside.
+//
+// Phases are the few coarse scopes of a run (parsing and each part). If AOC_PERF is set, they
+// also record the change in the `PERF_COUNTERS` over the phase, read through perf_event_open.
+// Counters the kernel or the machine cannot provide are left out of the report, together with
+// the reason, and the rest of the report is unaffected.
+
+#ifdef AOC_INSTRUMENT
+
+    #include <algorithm>
+    #include <array>
+    #include <cerrno>
+    #include <chrono>
+    #include <cstddef>
+    #include <cstdint>
+    #include <cstdio>
+    #include <cstdlib>
+    #include <cstring>
+    #include <map>
+    #include <memory>
+    #include <mutex>
+    #include <string>
+    #include <vector>
+
+    #if defined(__x86_64__) || defined(__i386__)
+        #include <x86intrin.h>
+    #endif
+
+    #ifdef __linux__
+        #include <linux/perf_event.h>
+        #include <sys/syscall.h>
+        #include <unistd.h>
+    #endif
+
+namespace instrument {
+
+struct PerfCounter {
+    const char*   name;
+    std::uint32_t type;
+    std::uint64_t config;
+};
+
+    #ifdef __linux__
+constexpr std::array<PerfCounter, 5> PERF_COUNTERS{{
+  {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+  {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+  {"cache_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+  {"branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+  {"page_faults", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+}};
+    #else
+constexpr std::array<PerfCounter, 0> PERF_COUNTERS{};
+    #endif
+
+using CounterValues = std::array<std::uint64_t, PERF_COUNTERS.size()>;
+
+struct Event {
+    const char*   name;
+    std::uint64_t start;
+    std::uint64_t end;
+    bool          phase;
+    CounterValues perf;
+};
+
+// The `PERF_COUNTERS` of the calling thread, each opened on its own so that one missing counter
+// does not disable the others. Counters are inherited by threads created afterwards, and their
+// counts are added in as those threads exit, so a phase that joins its workers includes them.
+class PerfCounters {
+   public:
+    PerfCounters() {
+        fds.fill(-1);
+        errors.fill(0);
+
+    #ifdef __linux__
+        for (std::size_t i = 0; i < PERF_COUNTERS.size(); i++)
+        {
+            perf_event_attr attr{};
+            attr.size           = sizeof(attr);
+            attr.type           = PERF_COUNTERS[i].type;
+            attr.config         = PERF_COUNTERS[i].config;
+            attr.inherit        = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv     = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+            fds[i] = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+
+            if (fds[i] < 0)
+                errors[i] = errno;
+        }
+    #endif
+    }
+
+    PerfCounters(const PerfCounters&)            = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    ~PerfCounters() {
+    #ifdef __linux__
+        for (const int fd : fds)
+            if (fd >= 0)
+                close(fd);
+    #endif
+    }
+
+    // Counts are scaled up when the kernel had to multiplex the counters. Unavailable counters
+    // read as 0.
+    CounterValues read() const noexcept {
+        CounterValues result{};
+
+    #ifdef __linux__
+        for (std::size_t i = 0; i < PERF_COUNTERS.size(); i++)
+        {
+            std::uint64_t value[3];
+
+            if (fds[i] < 0 || ::read(fds[i], value, sizeof(value)) != sizeof(value))
+                continue;
+
+            result[i] = value[2] == 0 || value[2] == value[1]
+                        ? value[0]
+                        : static_cast<std::uint64_t>(static_cast<double>(value[0]) * value[1]
+                                                     / value[2]);
+        }
+    #endif
+
+        return result;
+    }
+
+    // 0 if the counter is available, otherwise the errno from opening it.
+    int error(const std::size_t counter) const noexcept { return errors[counter]; }
+
+   private:
+    std::array<int, PERF_COUNTERS.size()> fds;
+    std::array<int, PERF_COUNTERS.size()> errors;
+};
+
+struct ThreadBuffer {
+    std::size_t                   thread_id;
+    std::vector<Event>            events;
+    std::vector<std::uint64_t>    counters;
+    std::unique_ptr<PerfCounters> perf;
+};
+
+inline std::uint64_t timestamp() noexcept {
+    #if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+    #else
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+    #endif
+}
+
+inline double steady_microseconds() noexcept {
+    return std::chrono::duration<double, std::micro>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Owns every thread's buffer, so buffers outlive their threads, and writes the report when it is
+// destroyed at exit.
+class Registry {
+   public:
+    Registry() :
+        start_ticks(timestamp()),
+        start_microseconds(steady_microseconds()),
+        perf_enabled(std::getenv("AOC_PERF") != nullptr) {}
+
+    Registry(const Registry&)            = delete;
+    Registry& operator=(const Registry&) = delete;
+
+    ~Registry() { report(); }
+
+    ThreadBuffer& new_thread_buffer() {
+        const std::lock_guard<std::mutex> lock{mutex};
+
+        buffers.push_back(std::make_unique<ThreadBuffer>());
+        buffers.back()->thread_id = buffers.size() - 1;
+        return *buffers.back();
+    }
+
+    std::size_t counter_id(const char* name) {
+        const std::lock_guard<std::mutex> lock{mutex};
+
+        counter_names.push_back(name);
+        return counter_names.size() - 1;
+    }
+
+    bool perf() const noexcept { return perf_enabled; }
+
+   private:
+    void report() const;
+
+    std::mutex                                 mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    std::vector<const char*>                   counter_names;
+    std::uint64_t                              start_ticks;
+    double                                     start_microseconds;
+    bool                                       perf_enabled;
+};
+
+inline Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+inline ThreadBuffer& thread_buffer() {
+    thread_local ThreadBuffer& buffer = registry().new_thread_buffer();
+    return buffer;
+}
+
+inline void count(const std::size_t id, const std::uint64_t amount) {
+    auto& counters = thread_buffer().counters;
+
+    if (id >= counters.size())
+        counters.resize(id + 1);
+
+    counters[id] += amount;
+}
+
+// Fetches the thread's buffer before reading the clock, so the registry, whose construction marks
+// time zero, always exists before the first recorded timestamp.
+class ScopedTimer {
+   public:
+    explicit ScopedTimer(const char* scope_name) :
+        buffer(thread_buffer()),
+        name(scope_name),
+        start(timestamp()) {}
+
+    ScopedTimer(const ScopedTimer&)            = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    ~ScopedTimer() { buffer.events.push_back(Event{name, start, timestamp(), false, {}}); }
+
+   private:
+    ThreadBuffer& buffer;
+    const char*   name;
+    std::uint64_t start;
+};
+
+// A scoped timer that also records the perf counters when AOC_PERF is set. The thread's counters
+// are opened by its first phase.
+class ScopedPhase {
+   public:
+    explicit ScopedPhase(const char* phase_name) :
+        buffer(thread_buffer()),
+        name(phase_name) {
+        if (registry().perf() && !buffer.perf)
+            buffer.perf = std::make_unique<PerfCounters>();
+
+        if (buffer.perf)
+            start_counts = buffer.perf->read();
+
+        start = timestamp();
+    }
+
+    ScopedPhase(const ScopedPhase&)            = delete;
+    ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+    ~ScopedPhase() {
+        const std::uint64_t end    = timestamp();
+        CounterValues       counts = buffer.perf ? buffer.perf->read() : CounterValues{};
+
+        for (std::size_t i = 0; i < PERF_COUNTERS.size(); i++)
+            counts[i] -= start_counts[i];
+
+        buffer.events.push_back(Event{name, start, end, true, counts});
+    }
+
+   private:
+    ThreadBuffer& buffer;
+    const char*   name;
+    CounterValues start_counts{};
+    std::uint64_t start = 0;
+};
+
+inline void Registry::report() const {
+    const double ticks_per_microsecond =
+      std::max(1e-9, (timestamp() - start_ticks) / (steady_microseconds() - start_microseconds));
+
+    const auto microseconds = [&](const std::uint64_t ticks) {
+        return (ticks - start_ticks) / ticks_per_microsecond;
+    };
+
+    struct ScopeTotal {
+        std::uint64_t calls = 0;
+        double        time  = 0;
+        bool          phase = false;
+        CounterValues perf{};
+    };
+
+    // Counters registered from several call sites under one name are merged.
+    std::map<std::string, ScopeTotal>    scopes;
+    std::map<std::string, std::uint64_t> counters;
+    const PerfCounters*                  perf = nullptr;
+
+    for (const auto& buffer : buffers)
+    {
+        for (const Event& event : buffer->events)
+        {
+            ScopeTotal& total = scopes[event.name];
+
+            total.calls++;
+            total.time += microseconds(event.end) - microseconds(event.start);
+            total.phase |= event.phase;
+
+            for (std::size_t i = 0; i < PERF_COUNTERS.size(); i++)
+                total.perf[i] += event.perf[i];
+        }
+
+        for (std::size_t id = 0; id < buffer->counters.size(); id++)
+            counters[counter_names[id]] += buffer->counters[id];
+
+        if (!perf && buffer->perf)
+            perf = buffer->perf.get();
+    }
+
+    const auto print_perf = [&](std::FILE* out, const CounterValues& values) {
+        for (std::size_t i = 0; i < PERF_COUNTERS.size(); i++)
+            if (!perf->error(i))
+                std::fprintf(out, ", \"%s\": %llu", PERF_COUNTERS[i].name,
+                             static_cast<unsigned long long>(values[i]));
+    };
+
+    const char* trace_path = std::getenv("AOC_TRACE");
+    std::FILE*  out        = trace_path ? std::fopen(trace_path, "w") : stderr;
+
+    if (!out)
+    {
+        std::fprintf(stderr, "instrument: cannot write %s\n", trace_path);
+        return;
+    }
+
+    std::fprintf(out, "{");
+
+    if (out != stderr)
+    {
+        const char* separator = "";
+
+        std::fprintf(out, "\"displayTimeUnit\": \"ns\", \"traceEvents\": [");
+
+        for (const auto& buffer : buffers)
+            for (const Event& event : buffer->events)
+            {
+                std::fprintf(out,
+                             "%s\n{\"name\": \"%s\", \"ph\": \"X\", \"pid\": 0, \"tid\": %zu, "
+                             "\"ts\": %.3f, \"dur\": %.3f, \"args\": {\"phase\": %s",
+                             separator, event.name, buffer->thread_id, microseconds(event.start),
+                             microseconds(event.end) - microseconds(event.start),
+                             event.phase ? "true" : "false");
+
+                if (event.phase && perf)
+                    print_perf(out, event.perf);
+
+                std::fprintf(out, "}}");
+                separator = ",";
+            }
+
+        const double end = microseconds(timestamp());
+
+        for (const auto& [name, total] : counters)
+        {
+            std::fprintf(out,
+                         "%s\n{\"name\": \"%s\", \"ph\": \"C\", \"pid\": 0, \"ts\": %.3f, "
+                         "\"args\": {\"value\": %llu}}",
+                         separator, name.c_str(), end, static_cast<unsigned long long>(total));
+            separator = ",";
+        }
+
+        std::fprintf(out, "\n], ");
+    }
+
+    std::fprintf(out, "\"scopes\": {");
+
+    for (auto it = scopes.begin(); it != scopes.end(); ++it)
+    {
+        std::fprintf(out, "%s\n  \"%s\": {\"calls\": %llu, \"total_us\": %.3f, \"phase\": %s",
+                     it == scopes.begin() ? "" : ",", it->first.c_str(),
+                     static_cast<unsigned long long>(it->second.calls), it->second.time,
+                     it->second.phase ? "true" : "false");
+
+        if (it->second.phase && perf)
+            print_perf(out, it->second.perf);
+
+        std::fprintf(out, "}");
+    }
+
+    std::fprintf(out, "\n}, \"counters\": {");
+
+    for (auto it = counters.begin(); it != counters.end(); ++it)
+        std::fprintf(out, "%s\n  \"%s\": %llu", it == counters.begin() ? "" : ",",
+                     it->first.c_str(), static_cast<unsigned long long>(it->second));
+
+    std::fprintf(out, "\n}");
+
+    // Why each perf counter is missing, if any is.
+    if (perf)
+    {
+        const char* separator = "";
+
+        std::fprintf(out, ", \"perf_unavailable\": {");
+
+        for (std::size_t i = 0; i < PERF_COUNTERS.size(); i++)
+            if (perf->error(i))
+            {
+                std::fprintf(out, "%s\n  \"%s\": \"%s\"", separator, PERF_COUNTERS[i].name,
+                             std::strerror(perf->error(i)));
+                separator = ",";
+            }
+
+        std::fprintf(out, "\n}");
+    }
+
+    std::fprintf(out, "}\n");
+
+    if (out != stderr)
+        std::fclose(out);
+}
+
+}  // namespace instrument
+
+    #define INSTRUMENT_CONCAT_IMPL(a, b) a##b
+    #define INSTRUMENT_CONCAT(a, b)      INSTRUMENT_CONCAT_IMPL(a, b)
+
+    #define INSTRUMENT_PHASE(name) \
+        const instrument::ScopedPhase INSTRUMENT_CONCAT(instrument_phase_, __LINE__) { name }
+
+    #define INSTRUMENT_SCOPE(name) \
+        const instrument::ScopedTimer INSTRUMENT_CONCAT(instrument_scope_, __LINE__) { name }
+
+    // Each call site looks its counter up once.
+    #define INSTRUMENT_COUNT(name, amount) \
+        do \
+        { \
+            static const std::size_t instrument_counter = instrument::registry().counter_id(name); \
+            instrument::count(instrument_counter, amount); \
+        } while (false)
+
+#else
+
+    #define INSTRUMENT_PHASE(name)         static_cast<void>(0)
+    #define INSTRUMENT_SCOPE(name)         static_cast<void>(0)
+    #define INSTRUMENT_COUNT(name, amount) static_cast<void>(0)
+
+#endif
@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+"""Compare the wall-clock time of two builds of the same day.
+
+Both binaries are run from the day's directory on the same input, their outputs are checked to
+be identical, and the median of several runs is reported with the speedup of the candidate. With
+a single binary, its time is reported alone.
+
+    python3 tools/bench.py 7 pgo/7/run-baseline 7/run
+
+With --counters, each binary is run once more with AOC_PERF set, and the per-phase times and
+perf counters it records are printed. This needs a build with -DAOC_INSTRUMENT (see
+common/instrument.hpp and `make counters-7`); for other builds, and for counters the machine does
+not provide, the report says so and the timings above are unaffected.
+"""
+
+import argparse
+import json
+import os
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+PERF_COLUMNS = ["cycles", "instructions", "cache_misses", "branch_misses", "page_faults"]
+
+
+def measure(binary, cwd, args, repeat):
+    output = None
+    samples = []
+    for _ in range(repeat):
+        start = time.perf_counter()
+        result = subprocess.run([binary, *args], cwd=cwd, check=True, capture_output=True)
+        samples.append(time.perf_counter() - start)
+        if output is not None and result.stdout != output:
+            sys.exit(f"{binary}: output differs between runs")
+        output = result.stdout
+    return statistics.median(samples), output
+
+
+def phase_counters(binary, cwd, args):
+    """Returns the instrumentation summary of one run, or None if the binary wrote none."""
+    with tempfile.TemporaryDirectory() as directory:
+        trace = os.path.join(directory, "trace.json")
+        env = dict(os.environ, AOC_PERF="1", AOC_TRACE=trace)
+        subprocess.run([binary, *args], cwd=cwd, env=env, check=True, capture_output=True)
+        if not os.path.exists(trace):
+            return None
+        with open(trace) as file:
+            return json.load(file)
+
+
+def print_phase_counters(label, summary):
+    if summary is None:
+        print(f"  {label}: no per-phase counters, binary not built with -DAOC_INSTRUMENT")
+        return
+
+    phases = {name: scope for name, scope in summary["scopes"].items() if scope.get("phase")}
+    columns = [column for column in PERF_COLUMNS
+               if any(column in scope for scope in phases.values())]
+
+    print(f"  {label}:")
+    print(f"    {'phase':<16}{'time ms':>10}" + "".join(f"{column:>15}" for column in columns)
+          + (f"{'IPC':>7}" if {"cycles", "instructions"} <= set(columns) else ""))
+
+    for name, scope in phases.items():
+        row = f"    {name:<16}{scope['total_us'] / 1e3:>10.2f}"
+        row += "".join(f"{scope.get(column, 0):>15}" for column in columns)
+        if {"cycles", "instructions"} <= set(columns) and scope["cycles"]:
+            row += f"{scope['instructions'] / scope['cycles']:>7.2f}"
+        print(row)
+
+    for counter, reason in summary.get("perf_unavailable", {}).items():
+        print(f"    {counter} unavailable: {reason}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("day")
+    parser.add_argument("baseline")
+    parser.add_argument("candidate", nargs="?")
+    parser.add_argument("--input", default="data.txt", help="input path, relative to the day")
+    parser.add_argument("--repeat", type=int, default=11)
+    parser.add_argument("--counters", action="store_true",
+                        help="report per-phase perf counters of instrumented builds")
+    args = parser.parse_args()
+
+    cwd = os.path.abspath(args.day)
+    if args.candidate:
+        binaries = {"baseline": args.baseline, "candidate": args.candidate}
+    else:
+        binaries = {args.baseline: args.baseline}
+    binaries = {label: os.path.abspath(binary) for label, binary in binaries.items()}
+
+    results = {label: measure(binary, cwd, [args.input], args.repeat)
+               for label, binary in binaries.items()}
+
+    if len({output for _, output in results.values()}) > 1:
+        outputs = "\n".join(repr(output) for _, output in results.values())
+        sys.exit(f"day {args.day}: outputs differ\n{outputs}")
+
+    if args.candidate:
+        baseline, candidate = results["baseline"][0], results["candidate"][0]
+        print(f"day {args.day}: baseline {baseline * 1e3:8.2f} ms"
+              f"  candidate {candidate * 1e3:8.2f} ms  speedup {baseline / candidate:5.2f}x")
+    else:
+        print(f"day {args.day}: {results[args.baseline][0] * 1e3:8.2f} ms")
+
+    if args.counters:
+        for label, binary in binaries.items():
+            print_phase_counters(label, phase_counters(binary, cwd, [args.input]))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,128 @@
+#!/usr/bin/env python3
+"""Check a build of a day against its golden answers and its reference implementation.
+
+The candidate must print the day's answer.txt on the bundled data.txt, and the expected output on
+the day's hand-written CASES. Both binaries are then run on inputs from tools/generate.py, one per
+seed, and must print the same output. reference.cpp is the day's solution as it was before any
+optimisation; it is only ever changed to keep it building.
+
+    python3 tools/check.py 7 7/run check/7/reference --seeds 5
+
+Every binary runs in a directory holding the input as data.txt, so the reference, which only reads
+data.txt, and the candidate see the same file. A mismatch prints the command that regenerates the
+failing input.
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+
+from generate import generate
+
+
+# Small inputs with known answers, run on the candidate alone. Day 7: as in the reference, a partial
+# result above the row's own target is dead even if a later zero could bring it back down; only
+# targets of other rows sharing a prefix must not widen that bound. Day 8: antennas 2 or 3 steps
+# apart along a line are in line with every cell between and beyond them, not just every second or
+# third one; the generator avoids such pairs because the reference gets them wrong.
+CASES = {
+    7: [
+        ("1: 2 0 1\n5: 2 0 1\n", "0\n0\n"),
+        ("10: 2 0 10\n", "10\n10\n"),
+    ],
+    8: [
+        ("a....\n.....\n..a..\n.....\n.....\n", "1\n5\n"),
+        ("a..a...\n", "1\n7\n"),
+    ],
+}
+
+
+class RunError(Exception):
+    pass
+
+
+def run(binary, cwd, timeout):
+    try:
+        result = subprocess.run([binary], cwd=cwd, capture_output=True, timeout=timeout)
+    except subprocess.TimeoutExpired:
+        raise RunError(f"{binary} timed out after {timeout} s")
+    if result.returncode != 0:
+        stderr = result.stderr.decode(errors="replace").strip()
+        raise RunError(f"{binary} exited with status {result.returncode}\n{stderr}")
+    return result.stdout.decode()
+
+
+def check(label, expected, binary, cwd, timeout):
+    """Runs `binary` in `cwd` and returns whether it printed `expected`, reporting any failure."""
+    try:
+        actual = run(binary, cwd, timeout)
+    except RunError as error:
+        print(f"  {label}: FAIL\n    {error}")
+        return False
+    if actual != expected:
+        print(f"  {label}: FAIL")
+        print(f"    expected: {expected!r}")
+        print(f"    actual:   {actual!r}")
+        return False
+    return True
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("day", type=int)
+    parser.add_argument("candidate")
+    parser.add_argument("reference")
+    parser.add_argument("--seed", type=int, default=1, help="first seed of the generated inputs")
+    parser.add_argument("--seeds", type=int, default=5, help="number of generated inputs")
+    parser.add_argument("--scale", type=int, default=1, help="scale of the generated inputs")
+    parser.add_argument("--timeout", type=float, default=120, help="seconds allowed per run")
+    args = parser.parse_args()
+
+    day = str(args.day)
+    candidate = os.path.abspath(args.candidate)
+    reference = os.path.abspath(args.reference)
+    failures = 0
+
+    with open(os.path.join(day, "answer.txt")) as file:
+        answer = file.read()
+
+    cases = CASES.get(args.day, [])
+
+    print(f"day {day}: {args.candidate}")
+
+    if not check("data.txt", answer, candidate, os.path.abspath(day), args.timeout):
+        failures += 1
+
+    with tempfile.TemporaryDirectory() as directory:
+        for number, (text, expected) in enumerate(cases, 1):
+            with open(os.path.join(directory, "data.txt"), "w") as file:
+                file.write(text)
+
+            if not check(f"case {number}", expected, candidate, directory, args.timeout):
+                failures += 1
+
+        for seed in range(args.seed, args.seed + args.seeds):
+            with open(os.path.join(directory, "data.txt"), "w") as file:
+                file.write(generate(args.day, seed, args.scale))
+
+            try:
+                expected = run(reference, directory, args.timeout)
+                passed = check(f"seed {seed}", expected, candidate, directory, args.timeout)
+            except RunError as error:
+                print(f"  seed {seed}: FAIL, reference failed\n    {error}")
+                passed = False
+
+            if not passed:
+                print(f"    input: python3 tools/generate.py {day} --seed {seed}"
+                      f" --scale {args.scale}")
+                failures += 1
+
+    total = 1 + len(cases) + args.seeds
+    print(f"  {total - failures}/{total} passed")
+    sys.exit(1 if failures else 0)
+
+
+if __name__ == "__main__":
+    main()
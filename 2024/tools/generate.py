@@ -0,0 +1,184 @@
+#!/usr/bin/env python3
+"""Generate synthetic puzzle inputs for the 2024 solutions.
+
+The generated inputs follow the format of each day's data.txt and are used to train profile-guided
+builds (and to stress the solutions) without touching the real puzzle inputs. Output is fully
+determined by the day, the seed and the scale.
+
+    python3 tools/generate.py 7 --seed 2024 --scale 2 > train.txt
+"""
+
+import argparse
+import math
+import random
+import string
+import sys
+
+
+def day1(rng, scale):
+    lines = []
+    for _ in range(1000 * scale):
+        lines.append(f"{rng.randint(10000, 99999)}   {rng.randint(10000, 99999)}")
+    return "\n".join(lines) + "\n"
+
+
+def day2(rng, scale):
+    lines = []
+    for _ in range(1000 * scale):
+        level = rng.randint(1, 99)
+        step = rng.choice([-1, 1])
+        report = [level]
+        for _ in range(rng.randint(4, 7)):
+            level += step * rng.randint(0, 4)
+            report.append(max(level, 0))
+        if rng.random() < 0.3:
+            report[rng.randrange(len(report))] = rng.randint(1, 99)
+        lines.append(" ".join(map(str, report)))
+    return "\n".join(lines) + "\n"
+
+
+def day3(rng, scale):
+    noise = "!@#$%^&*()[]{}<>;:,'/?-+ " + string.ascii_lowercase
+    chunks = []
+    for _ in range(700 * scale):
+        roll = rng.random()
+        if roll < 0.05:
+            chunks.append("do()")
+        elif roll < 0.1:
+            chunks.append("don't()")
+        elif roll < 0.6:
+            chunks.append(f"mul({rng.randint(1, 999)},{rng.randint(1, 999)})")
+        else:
+            chunks.append(f"{rng.choice(['mul', 'how', 'from', 'what'])}({rng.randint(1, 999)}]")
+        chunks.append("".join(rng.choice(noise) for _ in range(rng.randint(0, 12))))
+    text = "".join(chunks)
+    return "\n".join(text[i:i + 3000] for i in range(0, len(text), 3000)) + "\n"
+
+
+def day4(rng, scale):
+    size = 140 * scale
+    return "".join("".join(rng.choice("XMAS") for _ in range(size)) + "\n" for _ in range(size))
+
+
+def day5(rng, scale):
+    pages = rng.sample(range(10, 100), 49)
+    rules = [f"{pages[i]}|{pages[j]}" for i in range(len(pages)) for j in range(i + 1, len(pages))]
+    rng.shuffle(rules)
+    updates = []
+    for _ in range(200 * scale):
+        update = rng.sample(pages, rng.choice(range(5, 24, 2)))
+        if rng.random() < 0.5:
+            update.sort(key=pages.index)
+        updates.append(",".join(map(str, update)))
+    return "\n".join(rules) + "\n\n" + "\n".join(updates) + "\n"
+
+
+def guard_leaves(grid, x, y):
+    """Whether the guard starting at (x, y) facing up walks off the map instead of looping."""
+    size = len(grid)
+    dx, dy = -1, 0
+    seen = set()
+    while (x, y, dx, dy) not in seen:
+        seen.add((x, y, dx, dy))
+        nx, ny = x + dx, y + dy
+        if not (0 <= nx < size and 0 <= ny < size):
+            return True
+        if grid[nx][ny] == "#":
+            dx, dy = dy, -dx
+        else:
+            x, y = nx, ny
+    return False
+
+
+def day6(rng, scale):
+    # The puzzle guarantees that the guard's original route leaves the map; redraw until it does.
+    size = 130 * scale
+    while True:
+        grid = [["#" if rng.random() < 0.02 else "." for _ in range(size)] for _ in range(size)]
+        x, y = rng.randrange(size), rng.randrange(size)
+        grid[x][y] = "^"
+        if guard_leaves(grid, x, y):
+            return "".join("".join(row) + "\n" for row in grid)
+
+
+def day7(rng, scale):
+    operators = [
+        lambda a, b: a + b,
+        lambda a, b: a * b,
+        lambda a, b: int(f"{a}{b}"),
+    ]
+    lines = []
+    while len(lines) < 850 * scale:
+        # Occasional zero operands exercise the rows no evaluator may prune by magnitude.
+        operands = [0 if rng.random() < 0.03 else rng.randint(1, 999)
+                    for _ in range(rng.randint(3, 12))]
+        target = operands[0]
+        for operand in operands[1:]:
+            target = rng.choice(operators)(target, operand)
+        if rng.random() < 0.5:
+            target += rng.randint(1, 100)
+        if target < 10**15:
+            lines.append(f"{target}: {' '.join(map(str, operands))}")
+    return "\n".join(lines) + "\n"
+
+
+def day8(rng, scale):
+    # As in the puzzle inputs, no two antennas of a frequency are a multiple of a shorter grid step
+    # apart, so the harmonics of part two are the same whether or not that step is reduced. The
+    # hand-written CASES of tools/check.py cover the other kind.
+    size = 50 * scale
+    grid = [["." for _ in range(size)] for _ in range(size)]
+    frequencies = string.digits + string.ascii_letters
+    antennas = {frequency: [] for frequency in frequencies}
+    for _ in range(200 * scale * scale):
+        frequency = rng.choice(frequencies)
+        x, y = rng.randrange(size), rng.randrange(size)
+        if grid[x][y] != "." or any(math.gcd(x - ax, y - ay) > 1 for ax, ay in antennas[frequency]):
+            continue
+        grid[x][y] = frequency
+        antennas[frequency].append((x, y))
+    return "".join("".join(row) + "\n" for row in grid)
+
+
+def day9(rng, scale):
+    # Even digits are files and odd digits free spans. Empty free spans are common in the puzzle
+    # inputs; empty files are not, but the solutions should not trip over them either.
+    digits = []
+    for i in range(20000 * scale - 1):
+        if i % 2 == 1:
+            digits.append(rng.randint(0, 9))
+        else:
+            digits.append(0 if rng.random() < 0.01 else rng.randint(1, 9))
+    return "".join(map(str, digits)) + "\n"
+
+
+GENERATORS = {
+    1: day1,
+    2: day2,
+    3: day3,
+    4: day4,
+    5: day5,
+    6: day6,
+    7: day7,
+    8: day8,
+    9: day9,
+}
+
+
+def generate(day, seed, scale):
+    rng = random.Random(seed * 100 + day)
+    return GENERATORS[day](rng, scale)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("day", type=int, choices=sorted(GENERATORS))
+    parser.add_argument("--seed", type=int, default=2024)
+    parser.add_argument("--scale", type=int, default=1, help="linear size multiplier")
+    args = parser.parse_args()
+
+    sys.stdout.write(generate(args.day, args.seed, args.scale))
+
+
+if __name__ == "__main__":
+    main()